@@ -6,10 +6,16 @@ import PackageDescription
 let package = Package(
     name: "vsl",
     products: [
-        .library(name: "vsl", targets: ["vsl"])
+        .library(name: "vsl", targets: ["vsl"]),
+        .executable(name: "vsl-bench", targets: ["vsl-bench"]),
+        .executable(name: "vsl-accuracy", targets: ["vsl-accuracy"]),
+        .executable(name: "vsl-random", targets: ["vsl-random"])
     ],
     targets: [
-        .target(name: "vsl", dependencies: [])
+        .target(name: "vsl", dependencies: []),
+        .executableTarget(name: "vsl-bench", dependencies: []),
+        .executableTarget(name: "vsl-accuracy", dependencies: []),
+        .executableTarget(name: "vsl-random", dependencies: [])
     ],
     cxxLanguageStandard: .cxx20
 )
@@ -0,0 +1,350 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <numbers>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../vsl/include/vsl.h"
+
+// Accuracy sweep for the cxm approximations.
+//
+// Each function is evaluated over evenly strided IEEE bit patterns (or every float with --exhaustive) and compared
+// against the long double std:: function. For each function and type this reports:
+// - max ULP, max absolute and max relative error over the function's nominal domain,
+// - the valid range: the largest interval around the function's center where the error is within tolerance.
+//   (The error is absolute where |reference| < 1 and relative elsewhere.)
+//
+// Usage: vsl-accuracy [--exhaustive] [--precision fast|balanced|full] [--tolerance <t>] [--threads <n>] [function...]
+// Results are printed to stdout as JSON.
+//
+// The reference is long double, which only has 11 more bits than double on x86 and none on AArch64. That's plenty
+// for approximations that are accurate to float precision, but double results near 1 ULP aren't meaningful there.
+
+namespace {
+
+using Real = long double;
+
+// MARK: - Cases
+
+struct Case {
+    const char* name;
+    float (*approx_float)(float);
+    double (*approx_double)(double);
+    Real (*reference)(Real);
+    Real lo; // Nominal domain, where the approximation is meant to be used.
+    Real hi;
+    Real center; // The valid range is grown outward from here.
+};
+
+constexpr auto pi = std::numbers::pi_v<Real>;
+
+// cos(2 pi x) and sin(2 pi x), exact at quarter turns like cxm's phase functions. (std::cos(2 * pi * x) isn't, since
+// 2 pi x is rounded.) x is reduced to the nearest quarter turn k/4 plus r in [-1/8, 1/8], which is exact.
+auto phase_quadrant(Real x) -> std::pair<int, Real>
+{
+    const auto f = x - std::floor(x);
+    const auto k = std::nearbyint(4 * f);
+    return {int(k) % 4, f - k / 4};
+}
+
+auto cos_turns(Real x) -> Real
+{
+    const auto [k, r] = phase_quadrant(x);
+    const auto c = std::cos(2 * pi * r), s = std::sin(2 * pi * r);
+    return k == 0 ? c : k == 1 ? -s : k == 2 ? -c : s;
+}
+
+auto sin_turns(Real x) -> Real
+{
+    const auto [k, r] = phase_quadrant(x);
+    const auto c = std::cos(2 * pi * r), s = std::sin(2 * pi * r);
+    return k == 0 ? s : k == 1 ? c : k == 2 ? -s : -c;
+}
+
+template<vsl::Precision P>
+const auto cases = std::to_array<Case>({
+    {"trunc", [](float x) { return vsl::cxm::trunc(x); }, [](double x) { return vsl::cxm::trunc(x); }, [](Real x) { return std::trunc(x); }, -1e30, 1e30, 0},
+    {"floor", [](float x) { return vsl::cxm::floor(x); }, [](double x) { return vsl::cxm::floor(x); }, [](Real x) { return std::floor(x); }, -1e30, 1e30, 0},
+    {"ceil", [](float x) { return vsl::cxm::ceil(x); }, [](double x) { return vsl::cxm::ceil(x); }, [](Real x) { return std::ceil(x); }, -1e30, 1e30, 0},
+    {"round", [](float x) { return vsl::cxm::round(x); }, [](double x) { return vsl::cxm::round(x); }, [](Real x) { return std::floor(x + Real(0.5)); }, -1e30, 1e30, 0},
+    {"fmod", [](float x) { return vsl::cxm::fmod(x, 1.75f); }, [](double x) { return vsl::cxm::fmod(x, 1.75); }, [](Real x) { return std::fmod(x, Real(1.75)); }, -1000, 1000, 0},
+    {"wrap", [](float x) { return vsl::cxm::wrap(x); }, [](double x) { return vsl::cxm::wrap(x); }, [](Real x) { return x - std::floor(x); }, -1000, 1000, 0},
+    {"cos", [](float x) { return vsl::cxm::cos<P>(x); }, [](double x) { return vsl::cxm::cos<P>(x); }, [](Real x) { return std::cos(x); }, -6433, 6433, 0},
+    {"sin", [](float x) { return vsl::cxm::sin<P>(x); }, [](double x) { return vsl::cxm::sin<P>(x); }, [](Real x) { return std::sin(x); }, -6433, 6433, 0},
+    {"cos_phase", [](float x) { return vsl::cxm::cos_phase<P>(x); }, [](double x) { return vsl::cxm::cos_phase<P>(x); }, [](Real x) { return cos_turns(x); }, 0, 1, 0},
+    {"sin_phase", [](float x) { return vsl::cxm::sin_phase<P>(x); }, [](double x) { return vsl::cxm::sin_phase<P>(x); }, [](Real x) { return sin_turns(x); }, 0, 1, 0},
+    {"tan", [](float x) { return vsl::cxm::tan<P>(x); }, [](double x) { return vsl::cxm::tan<P>(x); }, [](Real x) { return std::tan(x); }, -1.57, 1.57, 0},
+    {"asin", [](float x) { return vsl::cxm::asin<P>(x); }, [](double x) { return vsl::cxm::asin<P>(x); }, [](Real x) { return std::asin(x); }, -1, 1, 0},
+    {"acos", [](float x) { return vsl::cxm::acos<P>(x); }, [](double x) { return vsl::cxm::acos<P>(x); }, [](Real x) { return std::acos(x); }, -1, 1, 0},
+    {"atan", [](float x) { return vsl::cxm::atan<P>(x); }, [](double x) { return vsl::cxm::atan<P>(x); }, [](Real x) { return std::atan(x); }, -1e30, 1e30, 0},
+    {"atan2", [](float x) { return vsl::cxm::atan2<P>(x, -0.7f); }, [](double x) { return vsl::cxm::atan2<P>(x, -0.7); }, [](Real x) { return std::atan2(x, Real(-0.7)); }, -1e30, 1e30, 0},
+    {"cosh", [](float x) { return vsl::cxm::cosh<P>(x); }, [](double x) { return vsl::cxm::cosh<P>(x); }, [](Real x) { return std::cosh(x); }, -88, 88, 0},
+    {"sinh", [](float x) { return vsl::cxm::sinh<P>(x); }, [](double x) { return vsl::cxm::sinh<P>(x); }, [](Real x) { return std::sinh(x); }, -88, 88, 0},
+    {"tanh", [](float x) { return vsl::cxm::tanh<P>(x); }, [](double x) { return vsl::cxm::tanh<P>(x); }, [](Real x) { return std::tanh(x); }, -20, 20, 0},
+    {"exp2", [](float x) { return vsl::cxm::exp2<P>(x); }, [](double x) { return vsl::cxm::exp2<P>(x); }, [](Real x) { return std::exp2(x); }, -126, 127, 0},
+    {"log2", [](float x) { return vsl::cxm::log2<P>(x); }, [](double x) { return vsl::cxm::log2<P>(x); }, [](Real x) { return std::log2(x); }, 1.17549435e-38, 3.4e38, 1},
+    {"exp", [](float x) { return vsl::cxm::exp<P>(x); }, [](double x) { return vsl::cxm::exp<P>(x); }, [](Real x) { return std::exp(x); }, -87, 88, 0},
+    {"log", [](float x) { return vsl::cxm::log<P>(x); }, [](double x) { return vsl::cxm::log<P>(x); }, [](Real x) { return std::log(x); }, 1.17549435e-38, 3.4e38, 1},
+    {"log10", [](float x) { return vsl::cxm::log10<P>(x); }, [](double x) { return vsl::cxm::log10<P>(x); }, [](Real x) { return std::log10(x); }, 1.17549435e-38, 3.4e38, 1},
+    {"logB", [](float x) { return vsl::cxm::logB<P>(10.f, x); }, [](double x) { return vsl::cxm::logB<P>(10.0, x); }, [](Real x) { return std::log10(x); }, 1.17549435e-38, 3.4e38, 1},
+    {"pow", [](float x) { return vsl::cxm::pow<P>(x, 1.5f); }, [](double x) { return vsl::cxm::pow<P>(x, 1.5); }, [](Real x) { return std::pow(x, Real(1.5)); }, 1e-20, 1e20, 1},
+    {"rcp", [](float x) { return vsl::cxm::rcp<P>(x); }, [](double x) { return vsl::cxm::rcp<P>(x); }, [](Real x) { return 1 / x; }, 1.17549435e-38, 8.5e37, 1},
+    {"rsqrt", [](float x) { return vsl::cxm::rsqrt<P>(x); }, [](double x) { return vsl::cxm::rsqrt<P>(x); }, [](Real x) { return 1 / std::sqrt(x); }, 1.17549435e-38, 3.4e38, 1},
+    {"sqrt", [](float x) { return vsl::cxm::sqrt<P>(x); }, [](double x) { return vsl::cxm::sqrt<P>(x); }, [](Real x) { return std::sqrt(x); }, 1.17549435e-38, 3.4e38, 1},
+    {"cbrt", [](float x) { return vsl::cxm::cbrt<P>(x); }, [](double x) { return vsl::cxm::cbrt<P>(x); }, [](Real x) { return std::cbrt(x); }, 1.17549435e-38, 3.4e38, 1},
+});
+
+// MARK: - Error
+
+/// The size of one unit in the last place of T at r.
+template<typename T>
+auto ulp(Real r) -> Real
+{
+    const auto e = std::ilogb(r);
+    const auto min_e = std::numeric_limits<T>::min_exponent - 1;
+    return std::ldexp(Real(1), std::max(e, min_e) - (std::numeric_limits<T>::digits - 1));
+}
+
+template<typename T>
+struct Stats {
+    Real max_ulp = 0;
+    Real max_abs = 0;
+    Real max_rel = 0;
+    T worst_input = 0;
+    size_t count = 0;
+    T fail_above = std::numeric_limits<T>::infinity(); // The smallest failing input above the center.
+    T fail_below = -std::numeric_limits<T>::infinity(); // The largest failing input below the center.
+
+    auto merge(const Stats& other) -> void
+    {
+        if (other.max_ulp > max_ulp) {
+            max_ulp = other.max_ulp;
+            worst_input = other.worst_input;
+        }
+        max_abs = std::max(max_abs, other.max_abs);
+        max_rel = std::max(max_rel, other.max_rel);
+        count += other.count;
+        fail_above = std::min(fail_above, other.fail_above);
+        fail_below = std::max(fail_below, other.fail_below);
+    }
+};
+
+// MARK: - Sweep
+
+template<typename T>
+using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+template<typename T>
+auto sweep_chunk(const Case& c, T (*approx)(T), Bits<T> first, Bits<T> stride, size_t n, Real tol) -> Stats<T>
+{
+    auto stats = Stats<T>{};
+    const auto center = static_cast<T>(c.center);
+
+    for (size_t k = 0; k < n; ++k) {
+        const auto x = std::bit_cast<T>(static_cast<Bits<T>>(first + k * stride));
+        if (!std::isfinite(x)) {
+            continue;
+        }
+
+        const auto ref = c.reference(x);
+        if (!std::isfinite(ref) || std::abs(ref) > std::numeric_limits<T>::max()) {
+            continue;
+        }
+
+        const auto approx_x = static_cast<Real>(approx(x));
+        const auto abs_err = std::isnan(approx_x) ? std::numeric_limits<Real>::infinity() : std::abs(approx_x - ref);
+        const auto rel_err = ref == 0 ? abs_err : abs_err / std::abs(ref);
+
+        // Valid range.
+        const auto err = std::abs(ref) < 1 ? abs_err : rel_err;
+        if (!(err <= tol)) {
+            if (x > center) {
+                stats.fail_above = std::min(stats.fail_above, x);
+            }
+            else if (x < center) {
+                stats.fail_below = std::max(stats.fail_below, x);
+            }
+        }
+
+        // Nominal domain.
+        if (x < c.lo || x > c.hi) {
+            continue;
+        }
+
+        const auto ulp_err = abs_err / ulp<T>(ref);
+        if (ulp_err > stats.max_ulp) {
+            stats.max_ulp = ulp_err;
+            stats.worst_input = x;
+        }
+        stats.max_abs = std::max(stats.max_abs, abs_err);
+        stats.max_rel = std::max(stats.max_rel, rel_err);
+        ++stats.count;
+    }
+
+    return stats;
+}
+
+/// Sweeps 2^log2_samples evenly strided bit patterns, split into chunks across threads.
+template<typename T>
+auto sweep(const Case& c, T (*approx)(T), unsigned log2_samples, Real tol, unsigned threads) -> Stats<T>
+{
+    constexpr auto bits = unsigned{sizeof(T) * 8};
+    const auto stride = Bits<T>{1} << (bits - log2_samples);
+    const auto samples = size_t{1} << log2_samples;
+    const auto chunk = std::min(samples, size_t{1} << 16);
+
+    auto next = std::atomic<size_t>{0};
+    auto total = Stats<T>{};
+    auto mutex = std::mutex{};
+
+    const auto work = [&] {
+        auto local = Stats<T>{};
+        for (auto start = next.fetch_add(chunk); start < samples; start = next.fetch_add(chunk)) {
+            const auto first = static_cast<Bits<T>>(start) * stride;
+            local.merge(sweep_chunk<T>(c, approx, first, stride, chunk, tol));
+        }
+        const auto lock = std::scoped_lock{mutex};
+        total.merge(local);
+    };
+
+    auto pool = std::vector<std::thread>{};
+    for (unsigned i = 0; i < threads; ++i) {
+        pool.emplace_back(work);
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    return total;
+}
+
+// MARK: - Report
+
+auto print_number(Real x) -> void
+{
+    if (std::isfinite(x)) {
+        std::printf("%.9Lg", x);
+    }
+    else {
+        std::printf("null"); // Unbounded.
+    }
+}
+
+template<typename T>
+auto print_result(const Case& c, const char* type, const Stats<T>& s, bool last) -> void
+{
+    std::printf("    {\"function\": \"%s\", \"type\": \"%s\", \"domain\": [", c.name, type);
+    print_number(c.lo);
+    std::printf(", ");
+    print_number(c.hi);
+    std::printf("], \"samples\": %zu, \"max_ulp\": ", s.count);
+    print_number(s.max_ulp);
+    std::printf(", \"worst_input\": ");
+    print_number(s.worst_input);
+    std::printf(", \"max_abs_error\": ");
+    print_number(s.max_abs);
+    std::printf(", \"max_rel_error\": ");
+    print_number(s.max_rel);
+    std::printf(", \"valid_range\": [");
+    print_number(s.fail_below);
+    std::printf(", ");
+    print_number(s.fail_above);
+    std::printf("]}%s\n", last ? "" : ",");
+}
+
+auto usage(const char* problem, const std::string& arg) -> int
+{
+    std::fprintf(stderr, "vsl-accuracy: %s '%s'\n", problem, arg.c_str());
+    std::fprintf(stderr, "Usage: vsl-accuracy [--exhaustive] [--precision fast|balanced|full] [--tolerance <t>] "
+                         "[--threads <n>] [function...]\n");
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto exhaustive = false;
+    auto precision = std::string("balanced");
+    auto tol = Real(1e-4);
+    auto threads = std::max(1u, std::thread::hardware_concurrency());
+    auto names = std::vector<std::string>{};
+
+    for (int i = 1; i < argc; ++i) {
+        const auto arg = std::string(argv[i]);
+        if (arg == "--exhaustive") {
+            exhaustive = true;
+        }
+        else if (arg == "--precision" && i + 1 < argc) {
+            precision = argv[++i];
+        }
+        else if (arg == "--tolerance" && i + 1 < argc) {
+            tol = std::strtold(argv[++i], nullptr);
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::max(1l, std::strtol(argv[++i], nullptr, 10)));
+        }
+        else if (arg.starts_with("--")) {
+            return usage("unknown option, or missing value for", arg);
+        }
+        else {
+            names.push_back(arg);
+        }
+    }
+
+    if (precision != "fast" && precision != "balanced" && precision != "full") {
+        return usage("unknown precision", precision);
+    }
+
+    // Only the polynomial functions have tiers. The rest are the same in every table.
+    const auto& table = precision == "fast" ? cases<vsl::Precision::fast>
+                      : precision == "full" ? cases<vsl::Precision::full>
+                      : cases<vsl::Precision::balanced>;
+
+    for (const auto& name : names) {
+        if (std::none_of(table.begin(), table.end(), [&](const Case& c) { return name == c.name; })) {
+            return usage("unknown function", name);
+        }
+    }
+
+    auto selected = std::vector<const Case*>{};
+    for (const auto& c : table) {
+        if (names.empty() || std::find(names.begin(), names.end(), c.name) != names.end()) {
+            selected.push_back(&c);
+        }
+    }
+
+    // Every float is 2^32 samples. Otherwise, 2^24 samples of each type.
+    const auto float_samples = exhaustive ? 32u : 24u;
+    const auto double_samples = 24u;
+
+    std::printf("{\n");
+    std::printf("  \"compiler\": \"%s\",\n", __VERSION__);
+    std::printf("  \"precision\": \"%s\",\n", precision.c_str());
+    std::printf("  \"tolerance\": %Lg,\n", tol);
+    std::printf("  \"exhaustive\": %s,\n", exhaustive ? "true" : "false");
+    std::printf("  \"results\": [\n");
+
+    for (size_t i = 0; i < selected.size(); ++i) {
+        const auto& c = *selected[i];
+        print_result(c, "float", sweep<float>(c, c.approx_float, float_samples, tol, threads), false);
+        print_result(c, "double", sweep<double>(c, c.approx_double, double_samples, tol, threads), i + 1 == selected.size());
+        std::fflush(stdout);
+    }
+
+    std::printf("  ]\n");
+    std::printf("}\n");
+
+    return 0;
+}
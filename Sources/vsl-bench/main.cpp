@@ -0,0 +1,564 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../vsl/include/vsl.h"
+
+// Microbenchmarks for the cxm::, vsl:: and std:: math functions.
+//
+// Every function is measured in two modes:
+// - latency: a dependent chain, x = seed + eps * f(x), so each call waits for the previous one.
+// - throughput: f applied over an independent buffer, so calls can overlap.
+// - random: throughput over the same inputs in a shuffled order. Only measured for table lookups (vsl::Lut),
+//   which depend on neighbouring inputs sharing cache lines. The 256-segment tables stay in L1; the
+//   8192-segment ones don't.
+//
+// The chain's own multiply-add is included in the latency numbers. The "none" rows measure it on its own.
+// Results are printed to stdout as JSON.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// MARK: - Timing
+
+/// Keeps the compiler from optimizing away the computation of a value.
+template<typename T>
+force_inline auto keep(const T& x) -> void
+{
+    asm volatile("" : : "r"(&x) : "memory");
+}
+
+/// Runs `run` repeatedly and returns the best time per element in nanoseconds.
+template<typename F>
+auto measure(F run, size_t elements_per_run) -> double
+{
+    const auto time = [&](size_t reps) {
+        const auto start = Clock::now();
+        for (size_t i = 0; i < reps; ++i) {
+            run();
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    // Find a repetition count that runs for at least 2 ms.
+    auto reps = size_t{1};
+    while (time(reps) < 2e6) {
+        reps *= 2;
+    }
+
+    auto best = time(reps);
+    for (size_t trial = 0; trial < 4; ++trial) {
+        best = std::min(best, time(reps));
+    }
+
+    return best / (reps * elements_per_run);
+}
+
+/// Estimates the core clock in GHz by timing a chain of dependent integer adds (one cycle each).
+/// (Register-register adds, because some cores fold chains of immediate adds at rename.)
+auto estimate_ghz() -> double
+{
+#if defined(__x86_64__) || defined(__aarch64__)
+    constexpr auto adds_per_iteration = 8;
+    constexpr auto iterations = size_t{1} << 20;
+
+    const auto ns = measure([] {
+        auto x = size_t{0};
+        for (size_t i = 0; i < iterations; ++i) {
+#if defined(__x86_64__)
+            asm volatile("add %0, %0\n add %0, %0\n add %0, %0\n add %0, %0\n"
+                         "add %0, %0\n add %0, %0\n add %0, %0\n add %0, %0" : "+r"(x));
+#else
+            asm volatile("add %0, %0, %0\n add %0, %0, %0\n add %0, %0, %0\n add %0, %0, %0\n"
+                         "add %0, %0, %0\n add %0, %0, %0\n add %0, %0, %0\n add %0, %0, %0" : "+r"(x));
+#endif
+        }
+        keep(x);
+    }, iterations * adds_per_iteration);
+
+    return 1 / ns;
+#else
+    return 0; // Unknown, so elements_per_cycle is reported as null.
+#endif
+}
+
+// MARK: - Report
+
+struct Result {
+    std::string function;
+    std::string impl;
+    std::string type;
+    std::string mode;
+    double ns_per_element;
+};
+
+template<typename X>
+constexpr auto type_name() -> const char*
+{
+    if constexpr (std::is_same_v<X, float>) { return "float"; }
+    else if constexpr (std::is_same_v<X, double>) { return "double"; }
+    else if constexpr (std::is_same_v<X, vsl::float4>) { return "float4"; }
+    else if constexpr (std::is_same_v<X, vsl::double2>) { return "double2"; }
+    else if constexpr (std::is_same_v<X, vsl::float16>) { return "float16"; }
+    else { static_assert(vsl::deferred_false_v<X>); }
+}
+
+auto isa_name() -> const char*
+{
+#if defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__)
+    return "avx2";
+#elif defined(__AVX__)
+    return "avx";
+#elif defined(__SSE4_2__)
+    return "sse4.2";
+#elif defined(__x86_64__)
+    return "sse2";
+#elif defined(__ARM_NEON)
+    return "neon";
+#else
+    return "unknown";
+#endif
+}
+
+auto print_json(const std::vector<Result>& results, double ghz) -> void
+{
+    std::printf("{\n");
+    std::printf("  \"compiler\": \"%s\",\n", __VERSION__);
+    std::printf("  \"isa\": \"%s\",\n", isa_name());
+    std::printf("  \"dispatch_isa\": \"%s\",\n", vsl::dispatch::name(vsl::dispatch::active()));
+    std::printf("  \"cpu_ghz\": %.3f,\n", ghz);
+    std::printf("  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        std::printf("    {\"function\": \"%s\", \"impl\": \"%s\", \"type\": \"%s\", \"mode\": \"%s\", "
+                    "\"ns_per_element\": %.4f, ",
+                    r.function.c_str(), r.impl.c_str(), r.type.c_str(), r.mode.c_str(), r.ns_per_element);
+        if (ghz > 0) {
+            std::printf("\"elements_per_cycle\": %.4f}", 1 / (r.ns_per_element * ghz));
+        }
+        else {
+            std::printf("\"elements_per_cycle\": null}");
+        }
+        std::printf("%s\n", i + 1 < results.size() ? "," : "");
+    }
+
+    std::printf("  ]\n");
+    std::printf("}\n");
+}
+
+// MARK: - Modes
+
+template<typename X, typename F>
+auto latency(F f, vsl::scalar_t<X> seed) -> double
+{
+    using S = vsl::scalar_t<X>;
+    constexpr auto chain = size_t{256};
+    constexpr auto eps = S(0x1p-20);
+
+    auto x = X(seed);
+    return measure([&] {
+        for (size_t i = 0; i < chain; ++i) {
+            x = X(seed) + eps * f(x);
+        }
+        keep(x);
+    }, chain * vsl::num_members_v<X>);
+}
+
+template<typename X, typename F>
+auto throughput(F f, vsl::scalar_t<X> lo, vsl::scalar_t<X> hi, bool shuffle = false) -> double
+{
+    using S = vsl::scalar_t<X>;
+    constexpr auto count = size_t{4096} / vsl::num_members_v<X>;
+
+    auto in = std::vector<X>(count);
+    auto out = std::vector<X>(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < vsl::num_members_v<X>; ++j) {
+            const auto t = S(i * vsl::num_members_v<X> + j) / (count * vsl::num_members_v<X>);
+            vsl::set_member(in[i], j, lo + t * (hi - lo));
+        }
+    }
+
+    if (shuffle) {
+        auto members = std::vector<S>(in.size() * vsl::num_members_v<X>);
+        std::memcpy(members.data(), in.data(), members.size() * sizeof(S));
+        std::shuffle(members.begin(), members.end(), std::mt19937{808});
+        std::memcpy(in.data(), members.data(), members.size() * sizeof(S));
+    }
+
+    return measure([&] {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = f(in[i]);
+        }
+        keep(out[0]);
+    }, count * vsl::num_members_v<X>);
+}
+
+// MARK: - Cases
+
+/// Makes a scalar function callable on vectors, one member at a time.
+template<typename F>
+auto per_member(F f)
+{
+    return [f](auto x) {
+        if constexpr (vsl::is_vector_v<decltype(x)>) {
+            for (size_t i = 0; i < vsl::num_members_v<decltype(x)>; ++i) {
+                vsl::set_member(x, i, f(x[i]));
+            }
+            return x;
+        }
+        else {
+            return f(x);
+        }
+    };
+}
+
+/// Stands in for an implementation that doesn't exist.
+struct None {};
+
+template<typename X>
+struct Bench {
+    using S = vsl::scalar_t<X>;
+
+    std::vector<Result>& results;
+
+    template<typename F>
+    auto run(const char* function, const char* impl, S lo, S hi, F f) -> void
+    {
+        if constexpr (!std::is_same_v<F, None>) {
+            results.push_back({function, impl, type_name<X>(), "latency", latency<X>(f, (lo + hi) / 2)});
+            results.push_back({function, impl, type_name<X>(), "throughput", throughput<X>(f, lo, hi)});
+        }
+    }
+
+    /// run(), plus the random mode.
+    template<typename F>
+    auto run_with_random(const char* function, const char* impl, S lo, S hi, F f) -> void
+    {
+        run(function, impl, lo, hi, f);
+        results.push_back({function, impl, type_name<X>(), "random", throughput<X>(f, lo, hi, true)});
+    }
+
+    template<typename C, typename V, typename D>
+    auto operator()(const char* function, S lo, S hi, C cxm_f, V vsl_f, D std_f) -> void
+    {
+        run(function, "cxm", lo, hi, cxm_f);
+        run(function, "vsl", lo, hi, vsl_f);
+        if constexpr (!std::is_same_v<D, None>) {
+            run(function, "std", lo, hi, per_member(std_f));
+        }
+    }
+};
+
+/// Forward transforms of n points, in ns per point. For vector X (Fft<float4> etc.) each member is a channel, so a
+/// point is one sample of one channel. Complex transforms work in place; real ones write n/2 + 1 bins.
+template<typename X>
+auto run_fft(std::vector<Result>& results, size_t n) -> void
+{
+    const auto function = "fft_" + std::to_string(n);
+    const auto points = n * vsl::num_members_v<X>;
+
+    auto in = std::vector<X>(2 * n);
+    for (size_t i = 0; i < in.size(); ++i) {
+        in[i] = X(std::sin(0.1 * i));
+    }
+    auto storage = std::vector<X>(2 * n + 2);
+    const auto z = vsl::Split_complex<X>{{storage.data(), n}, {storage.data() + n, n}};
+    const auto bins = vsl::Split_complex<X>{{storage.data(), n / 2 + 1}, {storage.data() + n + 1, n / 2 + 1}};
+
+    auto complex_fft = vsl::Fft<X>(n);
+    std::copy(in.begin(), in.end(), storage.begin());
+    results.push_back({function, "complex", type_name<X>(), "throughput", measure([&] {
+        complex_fft.forward(z, z);
+        keep(storage[0]);
+    }, points)});
+
+    auto real_fft = vsl::Real_fft<X>(n);
+    results.push_back({function, "real", type_name<X>(), "throughput", measure([&] {
+        real_fft.forward(std::span(in).first(n), bins);
+        keep(storage[0]);
+    }, points)});
+}
+
+/// Layout conversions for multichannel audio, in ns per sample, against a plain loop over frames and channels.
+template<typename S>
+auto run_channels(std::vector<Result>& results, size_t channels) -> void
+{
+    using V = vsl::vector_of_t<S, 16 / sizeof(S)>;
+    constexpr auto frames = size_t{1024};
+    const auto function = "channels_" + std::to_string(channels);
+    const auto samples = channels * frames;
+
+    auto interleaved = std::vector<S>(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        interleaved[i] = S(std::sin(0.1 * i));
+    }
+    auto storage = std::vector<S>(samples);
+    auto planar = std::vector<std::span<S>>{};
+    for (size_t c = 0; c < channels; ++c) {
+        planar.push_back(std::span(storage).subspan(c * frames, frames));
+    }
+    const auto planar_in = std::vector<std::span<const S>>(planar.begin(), planar.end());
+    auto packed = std::vector<V>(vsl::block::packed_size<V>(channels, frames));
+
+    results.push_back({function, "deinterleave", type_name<S>(), "throughput", measure([&] {
+        vsl::block::deinterleave(interleaved, planar);
+        keep(storage[0]);
+    }, samples)});
+
+    results.push_back({function, "deinterleave_loop", type_name<S>(), "throughput", measure([&] {
+        for (size_t f = 0; f < frames; ++f) {
+            for (size_t c = 0; c < channels; ++c) {
+                planar[c][f] = interleaved[f * channels + c];
+            }
+        }
+        keep(storage[0]);
+    }, samples)});
+
+    results.push_back({function, "interleave", type_name<S>(), "throughput", measure([&] {
+        vsl::block::interleave(planar_in, interleaved);
+        keep(interleaved[0]);
+    }, samples)});
+
+    results.push_back({function, "pack", type_name<S>(), "throughput", measure([&] {
+        vsl::block::pack<V>(planar_in, packed);
+        keep(packed[0][0]);
+    }, samples)});
+}
+
+/// Polar conversion of n spectrum bins, in ns per bin: the block kernels against a loop over std::hypot and
+/// std::atan2 (or std::polar).
+template<typename S>
+auto run_polar(std::vector<Result>& results, size_t n) -> void
+{
+    const auto function = "polar_" + std::to_string(n);
+
+    auto storage = std::vector<S>(4 * n);
+    for (size_t i = 0; i < 2 * n; ++i) {
+        storage[i] = S(std::sin(0.1 * i) + 0.3 * std::cos(0.037 * i));
+    }
+    const auto z = vsl::Split_complex<S>{{storage.data(), n}, {storage.data() + n, n}};
+    const auto mag = std::span(storage).subspan(2 * n, n);
+    const auto phase = std::span(storage).subspan(3 * n, n);
+
+    results.push_back({function, "to_polar", type_name<S>(), "throughput", measure([&] {
+        vsl::block::to_polar(z, mag, phase);
+        keep(storage[2 * n]);
+    }, n)});
+
+    results.push_back({function, "to_polar_std", type_name<S>(), "throughput", measure([&] {
+        for (size_t i = 0; i < n; ++i) {
+            mag[i] = std::hypot(z.real[i], z.imag[i]);
+            phase[i] = std::atan2(z.imag[i], z.real[i]);
+        }
+        keep(storage[2 * n]);
+    }, n)});
+
+    results.push_back({function, "from_polar", type_name<S>(), "throughput", measure([&] {
+        vsl::block::from_polar(mag, phase, z);
+        keep(storage[0]);
+    }, n)});
+
+    results.push_back({function, "from_polar_std", type_name<S>(), "throughput", measure([&] {
+        for (size_t i = 0; i < n; ++i) {
+            const auto c = std::polar(mag[i], phase[i]);
+            z.real[i] = c.real();
+            z.imag[i] = c.imag();
+        }
+        keep(storage[0]);
+    }, n)});
+}
+
+/// Random numbers into a buffer, in ns per scalar (GB/s is sizeof(scalar) / ns). Uniform: a loop over next(),
+/// Random_gen::fill, and the dispatched fill. The other distributions: fill, and std::normal_distribution.
+template<typename X>
+auto run_random(std::vector<Result>& results) -> void
+{
+    using S = vsl::scalar_t<X>;
+    constexpr auto width = vsl::num_members_v<X>;
+
+    auto gen = vsl::Random_gen<X>{-1, 1};
+    auto out = std::vector<S>(4096);
+
+    results.push_back({"random_uniform", "next", type_name<X>(), "throughput", measure([&] {
+        for (size_t i = 0; i < out.size(); i += width) {
+            const auto x = gen.next();
+            std::memcpy(out.data() + i, &x, sizeof(X));
+        }
+        keep(out[0]);
+    }, out.size())});
+
+    results.push_back({"random_uniform", "fill", type_name<X>(), "throughput", measure([&] {
+        gen.fill(out);
+        keep(out[0]);
+    }, out.size())});
+
+    results.push_back({"random_uniform", "dispatch_fill", type_name<X>(), "throughput", measure([&] {
+        vsl::dispatch::fill(gen, std::span(out));
+        keep(out[0]);
+    }, out.size())});
+
+    // The other engines, for the cost of their statistics (see vsl-random).
+    const auto run_engine = [&]<vsl::Random_engine E>(const char* impl) {
+        auto other = vsl::Random_gen<X, E>{-1, 1};
+        results.push_back({"random_uniform", impl, type_name<X>(), "throughput", measure([&] {
+            other.fill(out);
+            keep(out[0]);
+        }, out.size())});
+    };
+    run_engine.template operator()<vsl::Random_engine::xorshift>("fill_xorshift");
+    run_engine.template operator()<vsl::Random_engine::counter>("fill_counter");
+    run_engine.template operator()<vsl::Random_engine::pcg>("fill_pcg");
+    if constexpr (sizeof(S) == 4) {
+        run_engine.template operator()<vsl::Random_engine::xoshiro128_plus>("fill_xoshiro128_plus");
+    }
+    run_engine.template operator()<vsl::Random_engine::xoshiro256_plus>("fill_xoshiro256_plus");
+
+    const auto run_fill = [&](const char* function, auto dist) {
+        results.push_back({function, "fill", type_name<X>(), "throughput", measure([&] {
+            dist.fill(std::span(out));
+            keep(out[0]);
+        }, out.size())});
+    };
+    run_fill("random_normal", vsl::Normal_gen<X>{});
+    run_fill("random_exponential", vsl::Exponential_gen<X>{});
+    run_fill("random_triangular", vsl::Triangular_gen<X>{});
+
+    auto engine = std::mt19937{};
+    auto normal = std::normal_distribution<S>{};
+    results.push_back({"random_normal", "std", type_name<X>(), "throughput", measure([&] {
+        for (auto& x : out) {
+            x = normal(engine);
+        }
+        keep(out[0]);
+    }, out.size())});
+}
+
+/// sin over -pi...pi, tabulated. Built at startup, since the 8192-segment tables take more steps than Clang allows
+/// during constant evaluation by default.
+template<typename S, size_t N, vsl::Interpolation I>
+const auto sin_lut = vsl::lut<N, I>([](double x) { return vsl::cxm::sin<vsl::precision::full>(x); },
+                                        -std::numbers::pi_v<S>, std::numbers::pi_v<S>);
+
+/// A degree-5 fit of tanh on [-3, 3], for a waveshaper that doesn't need cxm::tanh's accuracy.
+template<typename S>
+constexpr auto tanh_poly_5 = vsl::minimax<5, S>(
+    [](double x) { return 1 - 2 / (vsl::cxm::exp<vsl::precision::full>(2 * x) + 1); }, -3, 3);
+
+template<typename X>
+auto run_all(std::vector<Result>& results) -> void
+{
+    using S = vsl::scalar_t<X>;
+    namespace cxm = vsl::cxm;
+    constexpr auto pi = std::numbers::pi_v<S>;
+    constexpr auto none = None{};
+
+    auto bench = Bench<X>{results};
+
+    bench.run("none", "none", -1, 1, [](auto x) { return x; });
+
+    bench("abs", -1, 1, [](auto x) { return cxm::abs(x); }, [](auto x) { return vsl::abs(x); }, [](S x) { return std::abs(x); });
+    bench("trunc", -100, 100, [](auto x) { return cxm::trunc(x); }, [](auto x) { return vsl::trunc(x); }, [](S x) { return std::trunc(x); });
+    bench("floor", -100, 100, [](auto x) { return cxm::floor(x); }, [](auto x) { return vsl::floor(x); }, [](S x) { return std::floor(x); });
+    bench("ceil", -100, 100, [](auto x) { return cxm::ceil(x); }, [](auto x) { return vsl::ceil(x); }, [](S x) { return std::ceil(x); });
+    bench("round", -100, 100, [](auto x) { return cxm::round(x); }, [](auto x) { return vsl::round(x); }, [](S x) { return std::round(x); });
+    bench("fmod", -10, 10, [](auto x) { return cxm::fmod(x, decltype(x)(0.7)); }, [](auto x) { return vsl::fmod(x, decltype(x)(0.7)); }, [](S x) { return std::fmod(x, S(0.7)); });
+    bench("wrap", -10, 10, [](auto x) { return cxm::wrap(x); }, [](auto x) { return vsl::wrap(x); }, none);
+    bench("wrap_range", -10, 10, [](auto x) { return cxm::wrap(x, -pi, pi); }, [](auto x) { return vsl::wrap(x, -pi, pi); }, none);
+
+    bench("cos", -pi, pi, [](auto x) { return cxm::cos(x); }, [](auto x) { return vsl::cos(x); }, [](S x) { return std::cos(x); });
+    bench("sin", -pi, pi, [](auto x) { return cxm::sin(x); }, [](auto x) { return vsl::sin(x); }, [](S x) { return std::sin(x); });
+    bench("sincos", -100, 100, [](auto x) { const auto [s, c] = cxm::sincos(x); return s + c; }, none, [](S x) { return std::sin(x) + std::cos(x); });
+    bench("sin_phase", 0, 1, [](auto x) { return cxm::sin_phase(x); }, none, [](S x) { return std::sin(2 * pi * x); });
+    bench("cos_phase", 0, 1, [](auto x) { return cxm::cos_phase(x); }, none, [](S x) { return std::cos(2 * pi * x); });
+    {
+        // The degree-12 polynomial (in x) behind cxm::cos for double, by each evaluation scheme.
+        using enum vsl::Poly_scheme;
+        constexpr auto c = std::array{0.99999999999993756, -0.16666666666432331, 0.008333333318765514,
+                                      -0.0001984126641162215, 2.7556931926594907e-6, -2.5029518865603179e-8,
+                                      1.5401170371414255e-10};
+        bench.run("poly_12", "horner", -1, 1, [=](auto x) { return cxm::poly<horner>(x * x, c); });
+        bench.run("poly_12", "estrin", -1, 1, [=](auto x) { return cxm::poly<estrin>(x * x, c); });
+    }
+    {
+        using enum vsl::Interpolation;
+        bench.run_with_random("sin", "cxm", -pi, pi, [](auto x) { return cxm::sin(x); });
+        bench.run_with_random("sin", "lut_linear_256", -pi, pi, [](auto x) { return sin_lut<S, 256, linear>(x); });
+        bench.run_with_random("sin", "lut_hermite_256", -pi, pi, [](auto x) { return sin_lut<S, 256, hermite>(x); });
+        bench.run_with_random("sin", "lut_chebyshev_256", -pi, pi, [](auto x) { return sin_lut<S, 256, chebyshev>(x); });
+        bench.run_with_random("sin", "lut_linear_8192", -pi, pi, [](auto x) { return sin_lut<S, 8192, linear>(x); });
+        bench.run_with_random("sin", "lut_hermite_8192", -pi, pi, [](auto x) { return sin_lut<S, 8192, hermite>(x); });
+    }
+    bench("tan", -1, 1, [](auto x) { return cxm::tan(x); }, [](auto x) { return vsl::tan(x); }, [](S x) { return std::tan(x); });
+    bench("asin", -0.9, 0.9, [](auto x) { return cxm::asin(x); }, [](auto x) { return vsl::asin(x); }, [](S x) { return std::asin(x); });
+    bench("acos", -0.9, 0.9, [](auto x) { return cxm::acos(x); }, [](auto x) { return vsl::acos(x); }, [](S x) { return std::acos(x); });
+    bench("atan", -4, 4, [](auto x) { return cxm::atan(x); }, [](auto x) { return vsl::atan(x); }, [](S x) { return std::atan(x); });
+    bench("atan2", -4, 4, [](auto x) { return cxm::atan2(decltype(x)(0.7), x); }, [](auto x) { return vsl::atan2(decltype(x)(0.7), x); }, [](S x) { return std::atan2(S(0.7), x); });
+
+    bench("cosh", -3, 3, [](auto x) { return cxm::cosh(x); }, [](auto x) { return vsl::cosh(x); }, [](S x) { return std::cosh(x); });
+    bench("sinh", -3, 3, [](auto x) { return cxm::sinh(x); }, [](auto x) { return vsl::sinh(x); }, [](S x) { return std::sinh(x); });
+    bench("tanh", -3, 3, [](auto x) { return cxm::tanh(x); }, [](auto x) { return vsl::tanh(x); }, [](S x) { return std::tanh(x); });
+    bench.run("tanh", "minimax_5", -3, 3, [](auto x) { return cxm::poly(x, tanh_poly_5<S>.coefficients); });
+    bench("acosh", 1.1, 10, none, [](auto x) { return vsl::acosh(x); }, [](S x) { return std::acosh(x); });
+    bench("asinh", -4, 4, none, [](auto x) { return vsl::asinh(x); }, [](S x) { return std::asinh(x); });
+    bench("atanh", -0.9, 0.9, none, [](auto x) { return vsl::atanh(x); }, [](S x) { return std::atanh(x); });
+    bench("erf", -2, 2, none, [](auto x) { return vsl::erf(x); }, [](S x) { return std::erf(x); });
+
+    bench("exp2", -10, 10, [](auto x) { return cxm::exp2(x); }, [](auto x) { return vsl::exp2(x); }, [](S x) { return std::exp2(x); });
+    bench("log2", 0.01, 100, [](auto x) { return cxm::log2(x); }, [](auto x) { return vsl::log2(x); }, [](S x) { return std::log2(x); });
+    bench("exp", -5, 5, [](auto x) { return cxm::exp(x); }, [](auto x) { return vsl::exp(x); }, [](S x) { return std::exp(x); });
+    bench("log", 0.01, 100, [](auto x) { return cxm::log(x); }, [](auto x) { return vsl::log(x); }, [](S x) { return std::log(x); });
+    bench("log10", 0.01, 100, [](auto x) { return cxm::log10(x); }, [](auto x) { return vsl::log10(x); }, [](S x) { return std::log10(x); });
+    bench("logB", 0.01, 100, [](auto x) { return cxm::logB(decltype(x)(2.5), x); }, [](auto x) { return vsl::logB(decltype(x)(2.5), x); }, [](S x) { return std::log2(x) / std::log2(S(2.5)); });
+    bench("pow", 0.1, 10, [](auto x) { return cxm::pow(x, decltype(x)(1.5)); }, [](auto x) { return vsl::pow(x, decltype(x)(1.5)); }, [](S x) { return std::pow(x, S(1.5)); });
+    bench("rcp", 0.01, 100, [](auto x) { return cxm::rcp(x); }, [](auto x) { return 1 / x; }, [](S x) { return 1 / x; });
+    bench("rsqrt", 0.01, 100, [](auto x) { return cxm::rsqrt(x); }, [](auto x) { return 1 / vsl::sqrt(x); }, [](S x) { return 1 / std::sqrt(x); });
+    bench("sqrt", 0.01, 100, [](auto x) { return cxm::sqrt(x); }, [](auto x) { return vsl::sqrt(x); }, [](S x) { return std::sqrt(x); });
+    bench("cbrt", 0.01, 100, [](auto x) { return cxm::cbrt(x); }, [](auto x) { return vsl::cbrt(x); }, [](S x) { return std::cbrt(x); });
+    bench("hypot", -10, 10, [](auto x) { return cxm::hypot(x, decltype(x)(0.7)); }, [](auto x) { return vsl::hypot(x, decltype(x)(0.7)); }, [](S x) { return std::hypot(x, S(0.7)); });
+
+    bench("min", -1, 1, [](auto x) { return cxm::min(x, S(0.25)); }, [](auto x) { return vsl::min(x, S(0.25)); }, [](S x) { return std::min(x, S(0.25)); });
+    bench("max", -1, 1, [](auto x) { return cxm::max(x, S(0.25)); }, [](auto x) { return vsl::max(x, S(0.25)); }, [](S x) { return std::max(x, S(0.25)); });
+    bench("clamp", -1, 1, [](auto x) { return cxm::clamp(x, S(-0.5), S(0.5)); }, [](auto x) { return vsl::clamp(x, S(-0.5), S(0.5)); }, [](S x) { return std::clamp(x, S(-0.5), S(0.5)); });
+    bench("sign", -1, 1, [](auto x) { return cxm::sign(x); }, [](auto x) { return vsl::sign(x); }, none);
+
+    for (const size_t n : {256, 1024, 4096}) {
+        run_fft<X>(results, n);
+    }
+
+    if constexpr (!vsl::is_vector_v<X>) {
+        for (const size_t channels : {2, 4, 6}) {
+            run_channels<X>(results, channels);
+        }
+        run_polar<X>(results, 1024);
+    }
+
+    run_random<X>(results);
+}
+
+} // namespace
+
+int main()
+{
+    auto results = std::vector<Result>{};
+
+    run_all<float>(results);
+    run_all<double>(results);
+    run_all<vsl::float4>(results);
+    run_all<vsl::double2>(results);
+
+    print_json(results, estimate_ghz());
+
+    return 0;
+}
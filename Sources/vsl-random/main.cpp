@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../vsl/include/vsl.h"
+
+// Statistical checks for the Random_gen engines, in the spirit of TestU01's SmallCrush (which isn't a dependency).
+//
+// Each engine runs as a float4 and a double2 generator over [0, 1), and its output is tested as the values a user
+// would see, after next() has dropped the low bits:
+// - frequency: chi-square of 4096 equal bins.
+// - low_bits: chi-square of the lowest 8 bits kept (of 24 for floats, of the top 32 for doubles).
+// - serial: chi-square of consecutive pairs from one lane, on a 64x64 grid.
+// - lanes: chi-square of lanes 0 and 1 at the same step, on a 64x64 grid. Identical or correlated lanes fail here.
+// - birthday_spacings: collisions among the spacings of 2^10 points in 2^24 cells, summed over 64 runs, which is
+//   Poisson with mean 1024.
+//
+// A p-value below 0.001 or above 0.999 is reported as a failure, like TestU01 does.
+//
+// Usage: vsl-random [--log2-samples <n>] [engine...]
+// Results are printed to stdout as JSON.
+
+namespace {
+
+using Engine = vsl::Random_engine;
+
+// MARK: - p-values
+
+/// P(X >= x) for a standard normal X.
+auto normal_upper(double z) -> double
+{
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+/// P(X >= x) for a chi-square X with k degrees of freedom, by the Wilson-Hilferty approximation.
+/// (Every test here has at least 255 degrees of freedom, where it's accurate to a few parts in a thousand.)
+auto chi_square_upper(double x, double k) -> double
+{
+    const auto z = (std::cbrt(x / k) - (1 - 2 / (9 * k))) / std::sqrt(2 / (9 * k));
+    return normal_upper(z);
+}
+
+auto chi_square(const std::vector<double>& counts) -> double
+{
+    auto total = 0.0;
+    for (const auto c : counts) {
+        total += c;
+    }
+    const auto expected = total / counts.size();
+
+    auto x = 0.0;
+    for (const auto c : counts) {
+        x += (c - expected) * (c - expected) / expected;
+    }
+    return chi_square_upper(x, double(counts.size() - 1));
+}
+
+// MARK: - Tests
+
+/// n steps of a two-lane (or wider) generator: value t of lane i is at [t * lanes + i].
+struct Sample {
+    std::vector<double> values;
+    size_t lanes;
+    unsigned bits; // How many bits of each value are random.
+
+    auto steps() const -> size_t { return values.size() / lanes; }
+    auto at(size_t t, size_t lane) const -> double { return values[t * lanes + lane]; }
+};
+
+auto frequency(const Sample& s) -> double
+{
+    auto counts = std::vector<double>(4096);
+    for (const auto u : s.values) {
+        ++counts[size_t(u * 4096)];
+    }
+    return chi_square(counts);
+}
+
+auto low_bits(const Sample& s) -> double
+{
+    const auto bits = std::min(s.bits, 32u);
+    auto counts = std::vector<double>(256);
+    for (const auto u : s.values) {
+        ++counts[uint64_t(std::ldexp(u, int(bits))) & 255];
+    }
+    return chi_square(counts);
+}
+
+auto serial(const Sample& s) -> double
+{
+    auto counts = std::vector<double>(64 * 64);
+    for (size_t t = 0; t + 1 < s.steps(); t += 2) {
+        ++counts[size_t(s.at(t, 0) * 64) * 64 + size_t(s.at(t + 1, 0) * 64)];
+    }
+    return chi_square(counts);
+}
+
+auto lanes(const Sample& s) -> double
+{
+    auto counts = std::vector<double>(64 * 64);
+    for (size_t t = 0; t < s.steps(); ++t) {
+        ++counts[size_t(s.at(t, 0) * 64) * 64 + size_t(s.at(t, 1) * 64)];
+    }
+    return chi_square(counts);
+}
+
+auto birthday_spacings(const Sample& s) -> double
+{
+    constexpr auto points = size_t{1} << 10;
+    constexpr auto runs = size_t{64};
+    constexpr auto mean = double(points * points * points) / (4.0 * (1 << 24)) * runs;
+
+    auto collisions = 0.0;
+    auto birthdays = std::vector<uint32_t>(points);
+    for (size_t run = 0; run < runs; ++run) {
+        for (size_t k = 0; k < points; ++k) {
+            birthdays[k] = uint32_t(s.values[run * points + k] * (1 << 24));
+        }
+        std::sort(birthdays.begin(), birthdays.end());
+        for (size_t k = points - 1; k > 0; --k) {
+            birthdays[k] -= birthdays[k - 1];
+        }
+        std::sort(birthdays.begin(), birthdays.end());
+        for (size_t k = 1; k < points; ++k) {
+            collisions += birthdays[k] == birthdays[k - 1];
+        }
+    }
+
+    // Poisson, by its normal approximation with a continuity correction.
+    return normal_upper((collisions - 0.5 - mean) / std::sqrt(mean));
+}
+
+// MARK: - Report
+
+struct Test {
+    const char* name;
+    double (*run)(const Sample&);
+};
+
+constexpr Test tests[] = {
+    {"frequency", frequency},
+    {"low_bits", low_bits},
+    {"serial", serial},
+    {"lanes", lanes},
+    {"birthday_spacings", birthday_spacings},
+};
+
+template<typename X, Engine E>
+auto run_engine(const char* engine, const char* type, size_t log2_samples, bool& first) -> void
+{
+    using S = vsl::scalar_t<X>;
+
+    auto gen = vsl::Random_gen<X, E>{0, 1};
+    auto out = std::vector<S>(size_t{1} << log2_samples);
+    gen.fill(std::span(out));
+
+    const auto sample = Sample{{out.begin(), out.end()}, vsl::num_members_v<X>, unsigned(vsl::ieee_sig_bits_v<S> + 1)};
+
+    for (const auto& test : tests) {
+        const auto p = test.run(sample);
+        const auto pass = p >= 0.001 && p <= 0.999;
+        std::printf("%s    {\"engine\": \"%s\", \"type\": \"%s\", \"test\": \"%s\", \"p_value\": %.4g, \"pass\": %s}",
+                    first ? "" : ",\n", engine, type, test.name, p, pass ? "true" : "false");
+        first = false;
+    }
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto log2_samples = size_t{22};
+    auto names = std::vector<std::string>{};
+
+    for (int i = 1; i < argc; ++i) {
+        const auto arg = std::string(argv[i]);
+        if (arg == "--log2-samples" && i + 1 < argc) {
+            log2_samples = std::clamp<size_t>(std::strtoul(argv[++i], nullptr, 10), 17, 30);
+        }
+        else {
+            names.push_back(arg);
+        }
+    }
+
+    const auto selected = [&](const char* name) {
+        return names.empty() || std::find(names.begin(), names.end(), name) != names.end();
+    };
+
+    std::printf("{\n");
+    std::printf("  \"compiler\": \"%s\",\n", __VERSION__);
+    std::printf("  \"samples\": %zu,\n", size_t{1} << log2_samples);
+    std::printf("  \"results\": [\n");
+
+    auto first = true;
+    const auto run = [&]<Engine E>(const char* name) {
+        if (selected(name)) {
+            run_engine<vsl::float4, E>(name, "float4", log2_samples, first);
+            if constexpr (E != Engine::xoshiro128_plus) {
+                run_engine<vsl::double2, E>(name, "double2", log2_samples, first);
+            }
+        }
+    };
+    run.template operator()<Engine::linear_congruential>("linear_congruential");
+    run.template operator()<Engine::xorshift>("xorshift");
+    run.template operator()<Engine::counter>("counter");
+    run.template operator()<Engine::pcg>("pcg");
+    run.template operator()<Engine::xoshiro128_plus>("xoshiro128_plus");
+    run.template operator()<Engine::xoshiro256_plus>("xoshiro256_plus");
+
+    std::printf("\n  ]\n");
+    std::printf("}\n");
+
+    return 0;
+}
@@ -0,0 +1,834 @@
+#ifndef _vsl_block_h
+#define _vsl_block_h
+
+#include <algorithm> // min
+#include <array>
+#include <cassert>
+#include <cstring> // memcpy
+#include <span>
+#include <utility> // index_sequence
+
+#include "_vsl_complex.h"
+#include "_vsl_core.h"
+#include "_vsl_cxm.h"
+#include "_vsl_math.h"
+
+namespace vsl::block {
+
+// MARK: - Definitions
+
+/**
+ * @brief The vector type block kernels use for a scalar type S.
+ *
+ * This is the widest vector the target has registers for, e.g. float8 and double4 with AVX.
+ *
+ * @tparam S A scalar type.
+ */
+template<typename S>
+using block_vector_t = vector_of_t<S, sizeof(native_float_t) / sizeof(S)>;
+
+/// The number of registers processed per loop iteration, so independent dependency chains can overlap.
+inline constexpr size_t unroll = 4;
+
+// MARK: - Loads and stores
+
+namespace detail {
+
+/// Loads a full register from (possibly unaligned) memory.
+template<typename V>
+force_inline auto load(const scalar_t<V>* p) -> V
+{
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+/// Stores a full register to (possibly unaligned) memory.
+template<typename V>
+force_inline auto store(scalar_t<V>* p, V v) -> void
+{
+    std::memcpy(p, &v, sizeof(V));
+}
+
+/// Loads the first n members of a register. The remaining members are zero.
+template<typename V>
+force_inline auto load_partial(const scalar_t<V>* p, size_t n) -> V
+{
+    auto v = V(0);
+    std::memcpy(&v, p, n * sizeof(scalar_t<V>));
+    return v;
+}
+
+/// Stores the first n members of a register.
+template<typename V>
+force_inline auto store_partial(scalar_t<V>* p, V v, size_t n) -> void
+{
+    std::memcpy(p, &v, n * sizeof(scalar_t<V>));
+}
+
+/// Loads n members, where n is either the register width or a partial tail.
+template<typename V>
+force_inline auto load_n(const scalar_t<V>* p, size_t n) -> V
+{
+    return n == num_members_v<V> ? load<V>(p) : load_partial<V>(p, n);
+}
+
+/// Stores n members, where n is either the register width or a partial tail.
+template<typename V>
+force_inline auto store_n(scalar_t<V>* p, V v, size_t n) -> void
+{
+    if (n == num_members_v<V>) {
+        store(p, v);
+    }
+    else {
+        store_partial(p, v, n);
+    }
+}
+
+} // namespace detail
+
+// MARK: - Transforms
+
+namespace detail {
+
+/// transform() over an explicit vector type V. (The dispatched kernels use this to pick a width per ISA.)
+template<typename V, typename F>
+force_inline auto transform(std::span<const scalar_t<V>> in, std::span<scalar_t<V>> out, F f) -> void
+{
+    constexpr auto width = num_members_v<V>;
+
+    assert(out.size() >= in.size());
+
+    const auto n = in.size();
+    const auto src = in.data();
+    const auto dst = out.data();
+    auto i = size_t{0};
+
+    for (; i + unroll * width <= n; i += unroll * width) {
+        V x[unroll];
+        for (size_t u = 0; u < unroll; ++u) {
+            x[u] = load<V>(src + i + u * width);
+        }
+        for (size_t u = 0; u < unroll; ++u) {
+            x[u] = f(x[u]);
+        }
+        for (size_t u = 0; u < unroll; ++u) {
+            store(dst + i + u * width, x[u]);
+        }
+    }
+
+    for (; i + width <= n; i += width) {
+        store(dst + i, f(load<V>(src + i)));
+    }
+
+    if (i < n) {
+        store_partial(dst + i, f(load_partial<V>(src + i, n - i)), n - i);
+    }
+}
+
+/// The binary transform() over an explicit vector type V.
+template<typename V, typename F>
+force_inline auto transform(std::span<const scalar_t<V>> a, std::span<const scalar_t<V>> b,
+                            std::span<scalar_t<V>> out, F f) -> void
+{
+    constexpr auto width = num_members_v<V>;
+
+    assert(b.size() >= a.size());
+    assert(out.size() >= a.size());
+
+    const auto n = a.size();
+    const auto src_a = a.data();
+    const auto src_b = b.data();
+    const auto dst = out.data();
+    auto i = size_t{0};
+
+    for (; i + unroll * width <= n; i += unroll * width) {
+        V x[unroll];
+        for (size_t u = 0; u < unroll; ++u) {
+            x[u] = f(load<V>(src_a + i + u * width), load<V>(src_b + i + u * width));
+        }
+        for (size_t u = 0; u < unroll; ++u) {
+            store(dst + i + u * width, x[u]);
+        }
+    }
+
+    for (; i + width <= n; i += width) {
+        store(dst + i, f(load<V>(src_a + i), load<V>(src_b + i)));
+    }
+
+    if (i < n) {
+        const auto x = f(load_partial<V>(src_a + i, n - i), load_partial<V>(src_b + i, n - i));
+        store_partial(dst + i, x, n - i);
+    }
+}
+
+/// A transform with two outputs. f returns a pair-like aggregate, e.g. cxm::Sin_cos.
+template<typename V, typename F>
+force_inline auto transform(std::span<const scalar_t<V>> in, std::span<scalar_t<V>> out_a,
+                            std::span<scalar_t<V>> out_b, F f) -> void
+{
+    constexpr auto width = num_members_v<V>;
+
+    assert(out_a.size() >= in.size());
+    assert(out_b.size() >= in.size());
+
+    const auto n = in.size();
+    const auto src = in.data();
+    const auto dst_a = out_a.data();
+    const auto dst_b = out_b.data();
+    auto i = size_t{0};
+
+    for (; i + unroll * width <= n; i += unroll * width) {
+        for (size_t u = 0; u < unroll; ++u) {
+            const auto [a, b] = f(load<V>(src + i + u * width));
+            store(dst_a + i + u * width, a);
+            store(dst_b + i + u * width, b);
+        }
+    }
+
+    for (; i + width <= n; i += width) {
+        const auto [a, b] = f(load<V>(src + i));
+        store(dst_a + i, a);
+        store(dst_b + i, b);
+    }
+
+    if (i < n) {
+        const auto [a, b] = f(load_partial<V>(src + i, n - i));
+        store_partial(dst_a + i, a, n - i);
+        store_partial(dst_b + i, b, n - i);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Applies a vector function to every element of a buffer.
+ *
+ * The loop runs over `unroll` registers at a time, then single registers, then a partial register for the tail.
+ * Loads and stores are unaligned, so buffers need no particular alignment. `in` and `out` may be the same buffer.
+ *
+ * @param in The input buffer.
+ * @param out The output buffer. (At least as long as `in`.)
+ * @param f A function that accepts and returns block_vector_t<S>.
+ */
+template<typename S, typename F>
+force_inline auto transform(std::span<const S> in, std::span<S> out, F f) -> void
+{
+    detail::transform<block_vector_t<S>>(in, out, f);
+}
+
+/**
+ * @brief Applies a binary vector function to every pair of elements of two buffers.
+ * @param a The first input buffer.
+ * @param b The second input buffer. (At least as long as `a`.)
+ * @param out The output buffer. (At least as long as `a`.)
+ * @param f A function that accepts two block_vector_t<S> and returns one.
+ */
+template<typename S, typename F>
+force_inline auto transform(std::span<const S> a, std::span<const S> b, std::span<S> out, F f) -> void
+{
+    detail::transform<block_vector_t<S>>(a, b, out, f);
+}
+
+// MARK: - Kernels
+
+// Every kernel has out-of-place and in-place overloads for float and double buffers. They aren't templates, so
+// anything convertible to a span (arrays, std::vector, std::array) can be passed directly.
+
+#define _VSL_BLOCK_UNARY_S(S, name, fn) \
+    inline auto name(std::span<const S> in, std::span<S> out) -> void \
+    { \
+        block::transform(in, out, [](auto v) { return fn(v); }); \
+    } \
+    inline auto name(std::span<S> x) -> void \
+    { \
+        block::transform(std::span<const S>(x), x, [](auto v) { return fn(v); }); \
+    }
+
+#define _VSL_BLOCK_BINARY_S(S, name, fn) \
+    inline auto name(std::span<const S> a, std::span<const S> b, std::span<S> out) -> void \
+    { \
+        block::transform(a, b, out, [](auto v, auto w) { return fn(v, w); }); \
+    } \
+    inline auto name(std::span<S> a, std::span<const S> b) -> void \
+    { \
+        block::transform(std::span<const S>(a), b, a, [](auto v, auto w) { return fn(v, w); }); \
+    }
+
+#define _VSL_BLOCK_RANGE_S(S, name, fn) \
+    inline auto name(std::span<const S> in, std::span<S> out, S lo, S hi) -> void \
+    { \
+        block::transform(in, out, [lo, hi](auto v) { return fn(v, lo, hi); }); \
+    } \
+    inline auto name(std::span<S> x, S lo, S hi) -> void \
+    { \
+        block::transform(std::span<const S>(x), x, [lo, hi](auto v) { return fn(v, lo, hi); }); \
+    }
+
+#define _VSL_BLOCK_SPLIT_S(S, name, fn) \
+    inline auto name(std::span<const S> in, std::span<S> out_a, std::span<S> out_b) -> void \
+    { \
+        block::detail::transform<block_vector_t<S>>(in, out_a, out_b, [](auto v) { return fn(v); }); \
+    }
+
+#define _VSL_BLOCK_UNARY(name, fn) _VSL_BLOCK_UNARY_S(float, name, fn) _VSL_BLOCK_UNARY_S(double, name, fn)
+#define _VSL_BLOCK_BINARY(name, fn) _VSL_BLOCK_BINARY_S(float, name, fn) _VSL_BLOCK_BINARY_S(double, name, fn)
+#define _VSL_BLOCK_RANGE(name, fn) _VSL_BLOCK_RANGE_S(float, name, fn) _VSL_BLOCK_RANGE_S(double, name, fn)
+#define _VSL_BLOCK_SPLIT(name, fn) _VSL_BLOCK_SPLIT_S(float, name, fn) _VSL_BLOCK_SPLIT_S(double, name, fn)
+
+// vsl:: math
+_VSL_BLOCK_UNARY(abs, vsl::abs)
+_VSL_BLOCK_UNARY(trunc, vsl::trunc)
+_VSL_BLOCK_UNARY(floor, vsl::floor)
+_VSL_BLOCK_UNARY(ceil, vsl::ceil)
+_VSL_BLOCK_UNARY(round, vsl::round)
+_VSL_BLOCK_BINARY(fmod, vsl::fmod)
+_VSL_BLOCK_UNARY(cos, vsl::cos)
+_VSL_BLOCK_UNARY(sin, vsl::sin)
+_VSL_BLOCK_UNARY(tan, vsl::tan)
+_VSL_BLOCK_UNARY(acos, vsl::acos)
+_VSL_BLOCK_UNARY(asin, vsl::asin)
+_VSL_BLOCK_UNARY(atan, vsl::atan)
+_VSL_BLOCK_BINARY(atan2, vsl::atan2) // (y, x, out)
+_VSL_BLOCK_UNARY(cosh, vsl::cosh)
+_VSL_BLOCK_UNARY(sinh, vsl::sinh)
+_VSL_BLOCK_UNARY(tanh, vsl::tanh)
+_VSL_BLOCK_UNARY(acosh, vsl::acosh)
+_VSL_BLOCK_UNARY(asinh, vsl::asinh)
+_VSL_BLOCK_UNARY(atanh, vsl::atanh)
+_VSL_BLOCK_UNARY(erf, vsl::erf)
+_VSL_BLOCK_UNARY(exp2, vsl::exp2)
+_VSL_BLOCK_UNARY(log2, vsl::log2)
+_VSL_BLOCK_UNARY(exp, vsl::exp)
+_VSL_BLOCK_UNARY(log, vsl::log)
+_VSL_BLOCK_UNARY(log10, vsl::log10)
+_VSL_BLOCK_BINARY(logB, vsl::logB)
+_VSL_BLOCK_BINARY(pow, vsl::pow)
+_VSL_BLOCK_UNARY(sqrt, vsl::sqrt)
+_VSL_BLOCK_UNARY(cbrt, vsl::cbrt)
+_VSL_BLOCK_BINARY(hypot, vsl::hypot)
+_VSL_BLOCK_BINARY(min, vsl::min)
+_VSL_BLOCK_BINARY(max, vsl::max)
+_VSL_BLOCK_RANGE(clamp, vsl::clamp)
+_VSL_BLOCK_UNARY(sign, vsl::sign)
+_VSL_BLOCK_UNARY(wrap, vsl::wrap)
+_VSL_BLOCK_RANGE(wrap, vsl::wrap)
+
+namespace cxm {
+
+// cxm:: approximations
+_VSL_BLOCK_UNARY(abs, vsl::cxm::abs)
+_VSL_BLOCK_UNARY(trunc, vsl::cxm::trunc)
+_VSL_BLOCK_UNARY(floor, vsl::cxm::floor)
+_VSL_BLOCK_UNARY(ceil, vsl::cxm::ceil)
+_VSL_BLOCK_UNARY(round, vsl::cxm::round)
+_VSL_BLOCK_BINARY(fmod, vsl::cxm::fmod)
+_VSL_BLOCK_UNARY(wrap, vsl::cxm::wrap)
+_VSL_BLOCK_RANGE(wrap, vsl::cxm::wrap)
+_VSL_BLOCK_UNARY(cos, vsl::cxm::cos)
+_VSL_BLOCK_UNARY(sin, vsl::cxm::sin)
+_VSL_BLOCK_SPLIT(sincos, vsl::cxm::sincos) // (in, sin_out, cos_out)
+_VSL_BLOCK_UNARY(cos_phase, vsl::cxm::cos_phase)
+_VSL_BLOCK_UNARY(sin_phase, vsl::cxm::sin_phase)
+_VSL_BLOCK_SPLIT(sincos_phase, vsl::cxm::sincos_phase) // (in, sin_out, cos_out)
+_VSL_BLOCK_UNARY(tan, vsl::cxm::tan)
+_VSL_BLOCK_UNARY(asin, vsl::cxm::asin)
+_VSL_BLOCK_UNARY(acos, vsl::cxm::acos)
+_VSL_BLOCK_UNARY(atan, vsl::cxm::atan)
+_VSL_BLOCK_BINARY(atan2, vsl::cxm::atan2) // (y, x, out)
+_VSL_BLOCK_UNARY(cosh, vsl::cxm::cosh)
+_VSL_BLOCK_UNARY(sinh, vsl::cxm::sinh)
+_VSL_BLOCK_UNARY(tanh, vsl::cxm::tanh)
+_VSL_BLOCK_UNARY(exp2, vsl::cxm::exp2)
+_VSL_BLOCK_UNARY(log2, vsl::cxm::log2)
+_VSL_BLOCK_UNARY(exp, vsl::cxm::exp)
+_VSL_BLOCK_UNARY(log, vsl::cxm::log)
+_VSL_BLOCK_UNARY(log10, vsl::cxm::log10)
+_VSL_BLOCK_BINARY(logB, vsl::cxm::logB)
+_VSL_BLOCK_BINARY(pow, vsl::cxm::pow)
+_VSL_BLOCK_UNARY(rcp, vsl::cxm::rcp)
+_VSL_BLOCK_UNARY(rsqrt, vsl::cxm::rsqrt)
+_VSL_BLOCK_UNARY(sqrt, vsl::cxm::sqrt)
+_VSL_BLOCK_UNARY(cbrt, vsl::cxm::cbrt)
+_VSL_BLOCK_BINARY(hypot, vsl::cxm::hypot)
+_VSL_BLOCK_BINARY(min, vsl::cxm::min)
+_VSL_BLOCK_BINARY(max, vsl::cxm::max)
+_VSL_BLOCK_RANGE(clamp, vsl::cxm::clamp)
+_VSL_BLOCK_UNARY(sign, vsl::cxm::sign)
+
+} // namespace cxm
+
+#undef _VSL_BLOCK_UNARY
+#undef _VSL_BLOCK_BINARY
+#undef _VSL_BLOCK_RANGE
+#undef _VSL_BLOCK_SPLIT
+#undef _VSL_BLOCK_UNARY_S
+#undef _VSL_BLOCK_BINARY_S
+#undef _VSL_BLOCK_RANGE_S
+#undef _VSL_BLOCK_SPLIT_S
+
+// MARK: - Complex
+
+namespace detail {
+
+/**
+ * @brief Calls f(i, n) for every register's worth of elements, where i is the first element and n the count.
+ *
+ * n is the register width everywhere but the tail, so load_n() and store_n() in f fold to full loads and stores.
+ */
+template<typename V, typename F>
+force_inline auto for_each_register(size_t count, F f) -> void
+{
+    constexpr auto width = num_members_v<V>;
+
+    auto i = size_t{0};
+    for (; i + width <= count; i += width) {
+        f(i, width);
+    }
+    if (i < count) {
+        f(i, count - i);
+    }
+}
+
+using vsl::detail::native;
+
+/// Loads n interleaved numbers (2n scalars) and splits them into a register of real parts and one of imaginary parts.
+template<typename V>
+force_inline auto load_interleaved(const scalar_t<V>* p, size_t n) -> Complex<V>
+{
+    constexpr auto width = num_members_v<V>;
+
+    const auto lo_count = std::min(2 * n, width);
+    const auto lo = native(load_n<V>(p, lo_count));
+    const auto hi = native(n == width ? load<V>(p + width) : load_partial<V>(p + width, 2 * n - lo_count));
+
+    return [&]<size_t... J>(std::index_sequence<J...>) __attribute__((always_inline)) {
+        return Complex<V>{V(__builtin_shufflevector(lo, hi, (2 * J)...)),
+                          V(__builtin_shufflevector(lo, hi, (2 * J + 1)...))};
+    }(std::make_index_sequence<width>{});
+}
+
+/// Stores the first n numbers of z interleaved (2n scalars).
+template<typename V>
+force_inline auto store_interleaved(scalar_t<V>* p, const Complex<V>& z, size_t n) -> void
+{
+    constexpr auto width = num_members_v<V>;
+
+    const auto re = native(z.real);
+    const auto im = native(z.imag);
+
+    // Member k of the pair comes from re or im (odd k) at k / 2.
+    const auto [lo, hi] = [&]<size_t... K>(std::index_sequence<K...>) __attribute__((always_inline)) {
+        return std::pair{V(__builtin_shufflevector(re, im, (K / 2 + K % 2 * width)...)),
+                         V(__builtin_shufflevector(re, im, (width / 2 + K / 2 + K % 2 * width)...))};
+    }(std::make_index_sequence<width>{});
+
+    if (n == width) {
+        store(p, lo);
+        store(p + width, hi);
+    }
+    else {
+        const auto lo_count = std::min(2 * n, width);
+        store_partial(p, lo, lo_count);
+        store_partial(p + width, hi, 2 * n - lo_count);
+    }
+}
+
+/// Loads n numbers from a split buffer, starting at i.
+template<typename V>
+force_inline auto load_split(Split_complex<const scalar_t<V>> x, size_t i, size_t n) -> Complex<V>
+{
+    return {load_n<V>(x.real.data() + i, n), load_n<V>(x.imag.data() + i, n)};
+}
+
+/// Stores n numbers to a split buffer, starting at i.
+template<typename V>
+force_inline auto store_split(Split_complex<scalar_t<V>> x, size_t i, const Complex<V>& z, size_t n) -> void
+{
+    store_n(x.real.data() + i, z.real, n);
+    store_n(x.imag.data() + i, z.imag, n);
+}
+
+template<typename V>
+force_inline auto deinterleave(std::span<const Complex<scalar_t<V>>> in, Split_complex<scalar_t<V>> out) -> void
+{
+    assert(out.real.size() >= in.size() && out.imag.size() >= in.size());
+
+    const auto src = reinterpret_cast<const scalar_t<V>*>(in.data());
+    for_each_register<V>(in.size(), [&](size_t i, size_t n) __attribute__((always_inline)) {
+        store_split(out, i, load_interleaved<V>(src + 2 * i, n), n);
+    });
+}
+
+template<typename V>
+force_inline auto interleave(Split_complex<const scalar_t<V>> in, std::span<Complex<scalar_t<V>>> out) -> void
+{
+    assert(in.imag.size() >= in.size() && out.size() >= in.size());
+
+    const auto dst = reinterpret_cast<scalar_t<V>*>(out.data());
+    for_each_register<V>(in.size(), [&](size_t i, size_t n) __attribute__((always_inline)) {
+        store_interleaved(dst + 2 * i, load_split<V>(in, i, n), n);
+    });
+}
+
+/// out = f(a, b), a register of numbers at a time.
+template<typename V, typename F>
+force_inline auto complex_transform(Split_complex<const scalar_t<V>> a, Split_complex<const scalar_t<V>> b,
+                                    Split_complex<scalar_t<V>> out, F f) -> void
+{
+    assert(b.size() >= a.size() && out.size() >= a.size());
+
+    for_each_register<V>(a.size(), [&](size_t i, size_t n) __attribute__((always_inline)) {
+        store_split(out, i, f(load_split<V>(a, i, n), load_split<V>(b, i, n)), n);
+    });
+}
+
+/// out = f(in), where f maps a register of numbers to a register of scalars.
+template<typename V, typename F>
+force_inline auto complex_reduce(Split_complex<const scalar_t<V>> in, std::span<scalar_t<V>> out, F f) -> void
+{
+    assert(out.size() >= in.size());
+
+    for_each_register<V>(in.size(), [&](size_t i, size_t n) __attribute__((always_inline)) {
+        store_n(out.data() + i, f(load_split<V>(in, i, n)), n);
+    });
+}
+
+} // namespace detail
+
+// Complex kernels, on split buffers (see vsl::Split_complex). Like the kernels above, they're overloads rather than
+// templates, so a Split_complex<float> converts to Split_complex<const float> where needed.
+
+#define _VSL_BLOCK_COMPLEX_S(S) \
+    /** Splits interleaved numbers into real and imaginary arrays. */ \
+    inline auto deinterleave(std::span<const Complex<S>> in, Split_complex<S> out) -> void \
+    { \
+        detail::deinterleave<block_vector_t<S>>(in, out); \
+    } \
+    /** Interleaves real and imaginary arrays into an array of numbers. */ \
+    inline auto interleave(Split_complex<const S> in, std::span<Complex<S>> out) -> void \
+    { \
+        detail::interleave<block_vector_t<S>>(in, out); \
+    } \
+    /** out = a * b. out may be a or b. */ \
+    inline auto cmul(Split_complex<const S> a, Split_complex<const S> b, Split_complex<S> out) -> void \
+    { \
+        detail::complex_transform<block_vector_t<S>>(a, b, out, [](const auto& x, const auto& y) { return x * y; }); \
+    } \
+    /** out = a * conj(b). out may be a or b. */ \
+    inline auto cmul_conj(Split_complex<const S> a, Split_complex<const S> b, Split_complex<S> out) -> void \
+    { \
+        detail::complex_transform<block_vector_t<S>>(a, b, out, [](const auto& x, const auto& y) { \
+            return vsl::mul_conj(x, y); \
+        }); \
+    } \
+    /** acc += a * b. */ \
+    inline auto cmac(Split_complex<const S> a, Split_complex<const S> b, Split_complex<S> acc) -> void \
+    { \
+        assert(b.size() >= a.size() && acc.size() >= a.size()); \
+        using V = block_vector_t<S>; \
+        detail::for_each_register<V>(a.size(), [&](size_t i, size_t n) __attribute__((always_inline)) { \
+            const auto sum = vsl::mac(detail::load_split<V>(acc, i, n), detail::load_split<V>(a, i, n), \
+                                      detail::load_split<V>(b, i, n)); \
+            detail::store_split(acc, i, sum, n); \
+        }); \
+    } \
+    /** out = |in|. */ \
+    inline auto mag(Split_complex<const S> in, std::span<S> out) -> void \
+    { \
+        detail::complex_reduce<block_vector_t<S>>(in, out, [](const auto& z) { return vsl::abs(z); }); \
+    } \
+    /** out = |in|^2. */ \
+    inline auto mag2(Split_complex<const S> in, std::span<S> out) -> void \
+    { \
+        detail::complex_reduce<block_vector_t<S>>(in, out, [](const auto& z) { return vsl::norm(z); }); \
+    } \
+    /** mag = |in| and phase = arg(in) in -pi...pi, with cxm::hypot and cxm::atan2. mag and phase may be in.real and \
+        in.imag. */ \
+    inline auto to_polar(Split_complex<const S> in, std::span<S> mag, std::span<S> phase) -> void \
+    { \
+        assert(mag.size() >= in.size() && phase.size() >= in.size()); \
+        using V = block_vector_t<S>; \
+        detail::for_each_register<V>(in.size(), [&](size_t i, size_t n) __attribute__((always_inline)) { \
+            const auto z = detail::load_split<V>(in, i, n); \
+            detail::store_n(mag.data() + i, vsl::cxm::hypot(z.real, z.imag), n); \
+            detail::store_n(phase.data() + i, vsl::cxm::atan2(z.imag, z.real), n); \
+        }); \
+    } \
+    /** out = mag * (cos(phase) + i sin(phase)), with cxm::sincos. out may be (mag, phase). */ \
+    inline auto from_polar(std::span<const S> mag, std::span<const S> phase, Split_complex<S> out) -> void \
+    { \
+        assert(phase.size() >= mag.size() && out.size() >= mag.size()); \
+        using V = block_vector_t<S>; \
+        detail::for_each_register<V>(mag.size(), [&](size_t i, size_t n) __attribute__((always_inline)) { \
+            const auto m = detail::load_n<V>(mag.data() + i, n); \
+            const auto [s, c] = vsl::cxm::sincos(detail::load_n<V>(phase.data() + i, n)); \
+            detail::store_split(out, i, Complex<V>{m * c, m * s}, n); \
+        }); \
+    }
+
+_VSL_BLOCK_COMPLEX_S(float)
+_VSL_BLOCK_COMPLEX_S(double)
+
+#undef _VSL_BLOCK_COMPLEX_S
+
+// MARK: - Channels
+
+// Multichannel audio comes in three layouts:
+// - interleaved: one frame of C samples after another, sample c of frame f at [f * C + c].
+// - planar: one span per channel.
+// - lane-packed: channel c in member c % W of a W-wide vector V, so a float4 buffer runs four channels through every
+//   kernel at once. With more than W channels, the channels are split into groups of W, and group g is the frames
+//   [g * frames, (g + 1) * frames) of the buffer; members past the last channel are zero.
+// Conversions between them transpose W x W tiles in registers. Partial loads and stores go through memcpy, so they
+// only happen at the end of a buffer: reading a full register past a channel group is harmless inside the buffer,
+// and a full store into an interleaved frame runs over into channels that are stored again afterwards.
+
+namespace detail {
+
+/// The registers deinterleave and interleave transpose: 4x4 floats, and 2x2 or (with 256-bit registers) 4x4 doubles.
+template<typename S>
+using tile_vector_t = vector_of_t<S, std::min<size_t>(4, num_members_v<block_vector_t<S>>)>;
+
+/// Calls f(i, n) for each block of up to W of count items.
+template<size_t W, typename F>
+force_inline auto for_each_tile(size_t count, F f) -> void
+{
+    for (size_t i = 0; i < count; i += W) {
+        f(i, std::min(W, count - i));
+    }
+}
+
+/**
+ * @brief Transposes a tile of up to W x W scalars, so dst(c)[r] is src(r)[c] for r < `rows` and c < `cols`.
+ *
+ * Row r is loaded as a full register if load_full(r), else as its first `cols` members. Register c is stored in full
+ * if store_full(c), else as its first `rows` members. Registers are stored in order.
+ */
+template<typename V, typename Src, typename Dst, typename Load_full, typename Store_full>
+force_inline auto transpose_tile(size_t rows, size_t cols, Src src, Dst dst, Load_full load_full,
+                                 Store_full store_full) -> void
+{
+    constexpr auto width = num_members_v<V>;
+
+    auto t = [&]<size_t... R>(std::index_sequence<R...>) __attribute__((always_inline)) {
+        return std::array<V, width>{
+            (R < rows ? (load_full(R) ? load<V>(src(R)) : load_partial<V>(src(R), cols)) : V(0))...};
+    }(std::make_index_sequence<width>{});
+    transpose(t);
+    [&]<size_t... C>(std::index_sequence<C...>) __attribute__((always_inline)) {
+        ((C < cols ? (store_full(C) ? store(dst(C), t[C]) : store_partial(dst(C), t[C], rows)) : void()), ...);
+    }(std::make_index_sequence<width>{});
+}
+
+/// transpose_tile for the partial tiles at the end of a buffer, out of line so it doesn't crowd the main loop.
+template<typename V, typename Src, typename Dst, typename Load_full, typename Store_full>
+__attribute__((noinline)) auto transpose_edge(size_t rows, size_t cols, Src src, Dst dst, Load_full load_full,
+                                              Store_full store_full) -> void
+{
+    transpose_tile<V>(rows, cols, src, dst, load_full, store_full);
+}
+
+inline constexpr auto always = [](size_t) { return true; };
+inline constexpr auto never = [](size_t) { return false; };
+
+template<typename V>
+force_inline auto deinterleave_channels(std::span<const scalar_t<V>> in, std::span<const std::span<scalar_t<V>>> out)
+    -> void
+{
+    constexpr auto width = num_members_v<V>;
+    const auto channels = out.size();
+    const auto frames = in.size() / channels;
+
+    for_each_tile<width>(channels, [&](size_t c0, size_t cols) __attribute__((always_inline)) {
+        for_each_tile<width>(frames, [&](size_t f0, size_t rows) __attribute__((always_inline)) {
+            const auto offset = [&](size_t r) __attribute__((always_inline)) { return (f0 + r) * channels + c0; };
+            const auto src = [&](size_t r) __attribute__((always_inline)) { return in.data() + offset(r); };
+            const auto dst = [&](size_t c) __attribute__((always_inline)) { return out[c0 + c].data() + f0; };
+            if (rows == width && offset(width - 1) + width <= in.size()) {
+                transpose_tile<V>(width, cols, src, dst, always, always);
+            }
+            else {
+                const auto fits = [&](size_t r) { return offset(r) + width <= in.size(); };
+                transpose_edge<V>(rows, cols, src, dst, fits, never);
+            }
+        });
+    });
+}
+
+template<typename V>
+force_inline auto interleave_channels(std::span<const std::span<const scalar_t<V>>> in, std::span<scalar_t<V>> out)
+    -> void
+{
+    constexpr auto width = num_members_v<V>;
+    const auto channels = in.size();
+    const auto frames = out.size() / channels;
+    const auto groups = (channels + width - 1) / width;
+
+    // Frames in order and the groups of each tile from last to first, so runover is always stored again.
+    for_each_tile<width>(frames, [&](size_t f0, size_t cols) __attribute__((always_inline)) {
+        for (size_t g = groups; g-- > 0;) {
+            const auto c0 = g * width;
+            const auto rows = std::min(width, channels - c0);
+            const auto offset = [&](size_t f) __attribute__((always_inline)) { return (f0 + f) * channels + c0; };
+            const auto src = [&](size_t r) __attribute__((always_inline)) { return in[c0 + r].data() + f0; };
+            const auto dst = [&](size_t f) __attribute__((always_inline)) { return out.data() + offset(f); };
+            const auto fits = [&](size_t f) __attribute__((always_inline)) {
+                return offset(f) + width <= frames * channels;
+            };
+            if (cols == width && fits(width - 1)) {
+                transpose_tile<V>(rows, width, src, dst, always, always);
+            }
+            else {
+                transpose_edge<V>(rows, cols, src, dst, [&](size_t) { return cols == width; }, fits);
+            }
+        }
+    });
+}
+
+} // namespace detail
+
+/// The number of vectors a lane-packed buffer of `channels` channels and `frames` frames takes.
+template<typename V>
+    requires is_vector_v<V>
+constexpr auto packed_size(size_t channels, size_t frames) -> size_t
+{
+    return (channels + num_members_v<V> - 1) / num_members_v<V> * frames;
+}
+
+/// Packs interleaved frames of `channels` samples into lanes. out needs packed_size<V>(channels, frames) vectors.
+template<typename V>
+    requires is_vector_v<V>
+auto pack(std::span<const scalar_t<V>> in, size_t channels, std::span<V> out) -> void
+{
+    constexpr auto width = num_members_v<V>;
+    assert(channels > 0);
+    const auto frames = in.size() / channels;
+    assert(out.size() >= packed_size<V>(channels, frames));
+
+    // Each frame of a group is already a register, with the next group's channels to mask off if it's partial.
+    detail::for_each_tile<width>(channels, [&](size_t c0, size_t n) __attribute__((always_inline)) {
+        const auto group = out.data() + c0 / width * frames;
+        const auto mask = [&]<size_t... K>(std::index_sequence<K...>) __attribute__((always_inline)) {
+            return V(((K < n) ? scalar_t<V>(1) : scalar_t<V>(0))...) != V(0);
+        }(std::make_index_sequence<width>{});
+        for (size_t f = 0; f < frames; ++f) {
+            const auto p = in.data() + f * channels + c0;
+            group[f] = p + width <= in.data() + in.size() ? select(mask, detail::load<V>(p), V(0))
+                                                          : detail::load_partial<V>(p, n);
+        }
+    });
+}
+
+/// Unpacks lanes into interleaved frames of `channels` samples.
+template<typename V>
+    requires is_vector_v<V>
+auto unpack(std::span<const V> in, size_t channels, std::span<scalar_t<V>> out) -> void
+{
+    constexpr auto width = num_members_v<V>;
+    assert(channels > 0);
+    const auto frames = out.size() / channels;
+    const auto groups = (channels + width - 1) / width;
+    assert(in.size() >= packed_size<V>(channels, frames));
+
+    // Like interleave, the groups of each frame from last to first.
+    for (size_t f = 0; f < frames; ++f) {
+        for (size_t g = groups; g-- > 0;) {
+            const auto offset = f * channels + g * width;
+            if (offset + width <= frames * channels) {
+                detail::store(out.data() + offset, in[g * frames + f]);
+            }
+            else {
+                detail::store_partial(out.data() + offset, in[g * frames + f], std::min(width, channels - g * width));
+            }
+        }
+    }
+}
+
+/// Packs in.size() planar channels into lanes. out needs packed_size<V>(in.size(), frames) vectors.
+template<typename V>
+    requires is_vector_v<V>
+auto pack(std::span<const std::span<const scalar_t<V>>> in, std::span<V> out) -> void
+{
+    constexpr auto width = num_members_v<V>;
+    const auto channels = in.size();
+    const auto frames = channels > 0 ? out.size() / packed_size<V>(channels, 1) : 0;
+
+    detail::for_each_tile<width>(channels, [&](size_t c0, size_t rows) __attribute__((always_inline)) {
+        const auto group = reinterpret_cast<scalar_t<V>*>(out.data() + c0 / width * frames);
+        detail::for_each_tile<width>(frames, [&](size_t f0, size_t cols) __attribute__((always_inline)) {
+            const auto src = [&](size_t r) __attribute__((always_inline)) { return in[c0 + r].data() + f0; };
+            const auto dst = [&](size_t f) __attribute__((always_inline)) { return group + (f0 + f) * width; };
+            if (cols == width) {
+                detail::transpose_tile<V>(rows, width, src, dst, detail::always, detail::always);
+            }
+            else {
+                detail::transpose_edge<V>(rows, cols, src, dst, detail::never, detail::always);
+            }
+        });
+    });
+}
+
+/// Unpacks lanes into out.size() planar channels.
+template<typename V>
+    requires is_vector_v<V>
+auto unpack(std::span<const V> in, std::span<const std::span<scalar_t<V>>> out) -> void
+{
+    constexpr auto width = num_members_v<V>;
+    const auto channels = out.size();
+    const auto frames = channels > 0 ? in.size() / packed_size<V>(channels, 1) : 0;
+
+    detail::for_each_tile<width>(channels, [&](size_t c0, size_t cols) __attribute__((always_inline)) {
+        const auto group = reinterpret_cast<const scalar_t<V>*>(in.data() + c0 / width * frames);
+        detail::for_each_tile<width>(frames, [&](size_t f0, size_t rows) __attribute__((always_inline)) {
+            const auto src = [&](size_t r) __attribute__((always_inline)) { return group + (f0 + r) * width; };
+            const auto dst = [&](size_t c) __attribute__((always_inline)) { return out[c0 + c].data() + f0; };
+            if (rows == width) {
+                detail::transpose_tile<V>(width, cols, src, dst, detail::always, detail::always);
+            }
+            else {
+                detail::transpose_edge<V>(rows, cols, src, dst, detail::always, detail::never);
+            }
+        });
+    });
+}
+
+// Like the complex kernels, these are overloads, so std::vector and std::array convert to spans.
+// Stereo is a complex buffer, so it takes the complex kernels' faster path.
+
+#define _VSL_BLOCK_CHANNELS_S(S) \
+    /** Splits interleaved frames into out.size() planar channels of in.size() / out.size() frames. */ \
+    inline auto deinterleave(std::span<const S> in, std::span<const std::span<S>> out) -> void \
+    { \
+        const auto frames = out.empty() ? 0 : in.size() / out.size(); \
+        assert(std::all_of(out.begin(), out.end(), [&](auto x) { return x.size() >= frames; })); \
+        if (out.size() == 2) { \
+            deinterleave(std::span(reinterpret_cast<const Complex<S>*>(in.data()), frames), \
+                         Split_complex<S>{out[0].first(frames), out[1].first(frames)}); \
+        } \
+        else if (!out.empty()) { \
+            detail::deinterleave_channels<detail::tile_vector_t<S>>(in, out); \
+        } \
+    } \
+    /** Interleaves in.size() planar channels into frames of out.size() / in.size() samples. */ \
+    inline auto interleave(std::span<const std::span<const S>> in, std::span<S> out) -> void \
+    { \
+        const auto frames = in.empty() ? 0 : out.size() / in.size(); \
+        assert(std::all_of(in.begin(), in.end(), [&](auto x) { return x.size() >= frames; })); \
+        if (in.size() == 2) { \
+            interleave(Split_complex<const S>{in[0].first(frames), in[1].first(frames)}, \
+                       std::span(reinterpret_cast<Complex<S>*>(out.data()), frames)); \
+        } \
+        else if (!in.empty()) { \
+            detail::interleave_channels<detail::tile_vector_t<S>>(in, out); \
+        } \
+    }
+
+_VSL_BLOCK_CHANNELS_S(float)
+_VSL_BLOCK_CHANNELS_S(double)
+
+#undef _VSL_BLOCK_CHANNELS_S
+
+} // namespace vsl::block
+
+#endif /* _vsl_block_h */
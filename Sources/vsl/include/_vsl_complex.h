@@ -1,6 +1,12 @@
 #ifndef _vsl_complex_h
 #define _vsl_complex_h
 
+#include <span>
+
+#include "_vsl_core.h"
+#include "_vsl_cxm.h" // mul_add
+#include "_vsl_math.h" // sqrt
+
 namespace vsl {
 
 template<typename X>
@@ -37,31 +43,30 @@ struct Complex {
     
     Complex operator*(const Complex& other) const
     {
-        return {real * other.real - imag * other.imag, real * other.imag + imag * other.real};
+        return {cxm::detail::mul_add(real, other.real, -(imag * other.imag)),
+                cxm::detail::mul_add(real, other.imag, imag * other.real)};
     }
     
     Complex& operator*=(const Complex& other)
     {
-        const auto new_real = real * other.real - imag * other.imag;
-        imag = real * other.imag + imag * other.real;
-        real = new_real;
-        return *this;
+        return *this = *this * other;
     }
     
     Complex operator/(const Complex& other) const
     {
-        const auto denom = other.real * other.real + other.imag * other.imag;
+        // One divide and two multiplies instead of two divides.
+        const auto inv_denom = X(1) / (other.real * other.real + other.imag * other.imag);
         return {
-            (real * other.real + imag * other.imag) / denom,
-            (imag * other.real - real * other.imag) / denom
+            (real * other.real + imag * other.imag) * inv_denom,
+            (imag * other.real - real * other.imag) * inv_denom
         };
     }
     
     Complex& operator/=(const Complex& other)
     {
-        const auto denom = other.real * other.real + other.imag * other.imag;
-        const auto new_real = (real * other.real + imag * other.imag) / denom;
-        imag = (imag * other.real - real * other.imag) / denom;
+        const auto inv_denom = X(1) / (other.real * other.real + other.imag * other.imag);
+        const auto new_real = (real * other.real + imag * other.imag) * inv_denom;
+        imag = (imag * other.real - real * other.imag) * inv_denom;
         real = new_real;
         return *this;
     }
@@ -119,11 +124,8 @@ struct Complex {
     
     friend Complex operator/(X scalar, const Complex& complex)
     {
-        const auto denom = complex.real * complex.real + complex.imag * complex.imag;
-        return {
-            (scalar * complex.real) / denom,
-            (-scalar * complex.imag) / denom
-        };
+        const auto scale = scalar / (complex.real * complex.real + complex.imag * complex.imag);
+        return {complex.real * scale, -complex.imag * scale};
     }
     
     Complex operator/(X scalar) const
@@ -139,6 +141,79 @@ struct Complex {
     }
 };
 
+// MARK: - Complex Functions
+
+// Built on cxm::detail::mul_add, so the multiply-adds fuse into FMAs where the target has them, with Clang too.
+
+/// The complex conjugate.
+template<typename X>
+force_inline constexpr auto conj(const Complex<X>& z) -> Complex<X>
+{
+    return {z.real, -z.imag};
+}
+
+/// The squared magnitude, |z|^2. (Like std::norm.)
+template<typename X>
+force_inline constexpr auto norm(const Complex<X>& z) -> X
+{
+    return cxm::detail::mul_add(z.real, z.real, z.imag * z.imag);
+}
+
+/// The magnitude, |z|. (Without the overflow protection of std::abs.)
+template<typename X>
+force_inline auto abs(const Complex<X>& z) -> X
+{
+    return vsl::sqrt(vsl::norm(z));
 }
 
+/// a * conj(b), as in a cross-spectrum or correlation.
+template<typename X>
+force_inline constexpr auto mul_conj(const Complex<X>& a, const Complex<X>& b) -> Complex<X>
+{
+    return {cxm::detail::mul_add(a.real, b.real, a.imag * b.imag),
+            cxm::detail::mul_add(a.imag, b.real, -(a.real * b.imag))};
+}
+
+/// acc + a * b.
+template<typename X>
+force_inline constexpr auto mac(const Complex<X>& acc, const Complex<X>& a, const Complex<X>& b) -> Complex<X>
+{
+    return {cxm::detail::mul_add(a.real, b.real, cxm::detail::mul_add(-a.imag, b.imag, acc.real)),
+            cxm::detail::mul_add(a.real, b.imag, cxm::detail::mul_add(a.imag, b.real, acc.imag))};
+}
+
+static_assert(norm(Complex<float>{3, 4}) == 25);
+static_assert(mul_conj(Complex<float>{1, 2}, Complex<float>{3, 4}).real == 11);
+static_assert(mul_conj(Complex<float>{1, 2}, Complex<float>{3, 4}).imag == 2);
+static_assert(mac(Complex<float>{1, 1}, Complex<float>{1, 2}, Complex<float>{3, 4}).imag == 11);
+
+// MARK: - Split Complex
+
+/**
+ * @brief A complex buffer stored as separate arrays of real and imaginary parts (split complex).
+ *
+ * An array of Complex<float> interleaves the parts, so a register holds halves of two numbers. Split, a register
+ * holds the real (or imaginary) parts of W numbers, and complex arithmetic is plain vector arithmetic. The block
+ * kernels in vsl::block work on this layout and convert to and from interleaved arrays.
+ *
+ * This is a view, like std::span. Both spans should have the same size.
+ *
+ * @tparam S A scalar type, possibly const.
+ */
+template<typename S>
+struct Split_complex {
+    std::span<S> real;
+    std::span<S> imag;
+
+    auto size() const -> size_t { return real.size(); }
+
+    /// The number at i.
+    auto operator[](size_t i) const -> Complex<std::remove_const_t<S>> { return {real[i], imag[i]}; }
+
+    /// A read-only view of the same buffer.
+    operator Split_complex<const S>() const requires (!std::is_const_v<S>) { return {real, imag}; }
+};
+
+} // namespace vsl
+
 #endif /* _vsl_complex_h */
@@ -1,26 +1,16 @@
 #ifndef _vsl_core_h
 #define _vsl_core_h
 
+#include <cstddef>
 #include <type_traits>
 
-#include <simd/simd.h>
-
-// MARK: - Macros
-
-/// Mainly for DEBUG builds.
-/// see: https://gcc.gnu.org/onlinedocs/gcc/Inline.html
-#ifndef force_inline
-#ifdef __GNUC__
-#define force_inline inline __attribute__((always_inline))
-#else
-#define force_inline inline
-#endif
-#endif
+#include "_vsl_simd.h" // simd backend, force_inline
 
 namespace vsl {
 
 // MARK: - Definitions and assumptions
 
+// 128-bit
 using float4 = simd::float4;
 using double2 = simd::double2;
 using int4 = simd::int4;
@@ -28,6 +18,22 @@ using long2 = simd::long2;
 using uint4 = simd::uint4;
 using ulong2 = simd::ulong2;
 
+// 256-bit
+using float8 = simd::float8;
+using double4 = simd::double4;
+using int8 = simd::int8;
+using long4 = simd::long4;
+using uint8 = simd::uint8;
+using ulong4 = simd::ulong4;
+
+// 512-bit
+using float16 = simd::float16;
+using double8 = simd::double8;
+using int16 = simd::int16;
+using long8 = simd::long8;
+using uint16 = simd::uint16;
+using ulong8 = simd::ulong8;
+
 using int1 = simd::int1;
 using long1 = simd::long1;
 using uint1 = simd::uint1;
@@ -64,7 +70,7 @@ inline constexpr bool is_one_of_v = is_one_of<T, Ts...>::value;
  * @tparam T The type to check.
  */
 template<typename T>
-struct is_vector_unsigned : is_one_of<T, uint4, ulong2> {};
+struct is_vector_unsigned : is_one_of<T, uint4, ulong2, uint8, ulong4, uint16, ulong8> {};
 
 template<typename T>
 inline constexpr bool is_vector_unsigned_v = is_vector_unsigned<T>::value;
@@ -74,7 +80,7 @@ inline constexpr bool is_vector_unsigned_v = is_vector_unsigned<T>::value;
  * @tparam T The type to check.
  */
 template<typename T>
-struct is_vector_signed : is_one_of<T, int4, long2> {};
+struct is_vector_signed : is_one_of<T, int4, long2, int8, long4, int16, long8> {};
 
 template<typename T>
 inline constexpr bool is_vector_signed_v = is_vector_signed<T>::value;
@@ -94,7 +100,7 @@ inline constexpr bool is_vector_integral_v = is_vector_integral<T>::value;
  * @tparam T The type to check.
  */
 template<typename T>
-struct is_vector_floating_point : is_one_of<T, float4, double2> {};
+struct is_vector_floating_point : is_one_of<T, float4, double2, float8, double4, float16, double8> {};
 
 template<typename T>
 inline constexpr bool is_vector_floating_point_v = is_vector_floating_point<T>::value;
@@ -224,6 +230,42 @@ struct scalar_eq<uint4> { typedef uint1 type; };
 template<>
 struct scalar_eq<ulong2> { typedef ulong1 type; };
 
+template<>
+struct scalar_eq<float8> { typedef float type; };
+
+template<>
+struct scalar_eq<double4> { typedef double type; };
+
+template<>
+struct scalar_eq<int8> { typedef int1 type; };
+
+template<>
+struct scalar_eq<long4> { typedef long1 type; };
+
+template<>
+struct scalar_eq<uint8> { typedef uint1 type; };
+
+template<>
+struct scalar_eq<ulong4> { typedef ulong1 type; };
+
+template<>
+struct scalar_eq<float16> { typedef float type; };
+
+template<>
+struct scalar_eq<double8> { typedef double type; };
+
+template<>
+struct scalar_eq<int16> { typedef int1 type; };
+
+template<>
+struct scalar_eq<long8> { typedef long1 type; };
+
+template<>
+struct scalar_eq<uint16> { typedef uint1 type; };
+
+template<>
+struct scalar_eq<ulong8> { typedef ulong1 type; };
+
 /**
  * @brief Alias for the scalar equivalent of a type T.
  * @tparam T The type to get the scalar equivalent of.
@@ -263,6 +305,78 @@ struct vector_eq<ulong1> { typedef ulong2 type; };
 template<typename T>
 using vector_t = typename vector_eq<T>::type;
 
+/**
+ * @brief Maps a scalar type and a number of members to the corresponding vector type.
+ *
+ * Unlike vector_eq, which always gives the 128-bit type, this can be used to pick a wider type.
+ * For example, the vector of 8 floats is float8.
+ *
+ * @tparam T The scalar type.
+ * @tparam N The number of members.
+ */
+template<typename T, size_t N>
+struct vector_of { static_assert(deferred_false_v<T>, "No suitable vector type defined."); };
+
+template<typename T>
+struct vector_of<T, 1> { typedef T type; };
+
+template<>
+struct vector_of<float, 4> { typedef float4 type; };
+
+template<>
+struct vector_of<double, 2> { typedef double2 type; };
+
+template<>
+struct vector_of<int1, 4> { typedef int4 type; };
+
+template<>
+struct vector_of<long1, 2> { typedef long2 type; };
+
+template<>
+struct vector_of<uint1, 4> { typedef uint4 type; };
+
+template<>
+struct vector_of<ulong1, 2> { typedef ulong2 type; };
+
+template<>
+struct vector_of<float, 8> { typedef float8 type; };
+
+template<>
+struct vector_of<double, 4> { typedef double4 type; };
+
+template<>
+struct vector_of<int1, 8> { typedef int8 type; };
+
+template<>
+struct vector_of<long1, 4> { typedef long4 type; };
+
+template<>
+struct vector_of<uint1, 8> { typedef uint8 type; };
+
+template<>
+struct vector_of<ulong1, 4> { typedef ulong4 type; };
+
+template<>
+struct vector_of<float, 16> { typedef float16 type; };
+
+template<>
+struct vector_of<double, 8> { typedef double8 type; };
+
+template<>
+struct vector_of<int1, 16> { typedef int16 type; };
+
+template<>
+struct vector_of<long1, 8> { typedef long8 type; };
+
+template<>
+struct vector_of<uint1, 16> { typedef uint16 type; };
+
+template<>
+struct vector_of<ulong1, 8> { typedef ulong8 type; };
+
+template<typename T, size_t N>
+using vector_of_t = typename vector_of<T, N>::type;
+
 /**
  * @brief Maps a type to its signed counterpart type.
  *
@@ -298,6 +412,30 @@ struct signed_counterpart<int4> { typedef float4 type; };
 template<>
 struct signed_counterpart<long2> { typedef double2 type; };
 
+template<>
+struct signed_counterpart<float8> { typedef int8 type; };
+
+template<>
+struct signed_counterpart<double4> { typedef long4 type; };
+
+template<>
+struct signed_counterpart<int8> { typedef float8 type; };
+
+template<>
+struct signed_counterpart<long4> { typedef double4 type; };
+
+template<>
+struct signed_counterpart<float16> { typedef int16 type; };
+
+template<>
+struct signed_counterpart<double8> { typedef long8 type; };
+
+template<>
+struct signed_counterpart<int16> { typedef float16 type; };
+
+template<>
+struct signed_counterpart<long8> { typedef double8 type; };
+
 template<typename T>
 using signed_counterpart_t = typename signed_counterpart<T>::type;
 
@@ -336,6 +474,30 @@ struct unsigned_counterpart<uint4> { typedef float4 type; };
 template<>
 struct unsigned_counterpart<ulong2> { typedef double2 type; };
 
+template<>
+struct unsigned_counterpart<float8> { typedef uint8 type; };
+
+template<>
+struct unsigned_counterpart<double4> { typedef ulong4 type; };
+
+template<>
+struct unsigned_counterpart<uint8> { typedef float8 type; };
+
+template<>
+struct unsigned_counterpart<ulong4> { typedef double4 type; };
+
+template<>
+struct unsigned_counterpart<float16> { typedef uint16 type; };
+
+template<>
+struct unsigned_counterpart<double8> { typedef ulong8 type; };
+
+template<>
+struct unsigned_counterpart<uint16> { typedef float16 type; };
+
+template<>
+struct unsigned_counterpart<ulong8> { typedef double8 type; };
+
 template<typename T>
 using unsigned_counterpart_t = typename unsigned_counterpart<T>::type;
 
@@ -362,6 +524,18 @@ struct unsigned_eq<int4> { typedef uint4 type; };
 template<>
 struct unsigned_eq<long2> { typedef ulong2 type; };
 
+template<>
+struct unsigned_eq<int8> { typedef uint8 type; };
+
+template<>
+struct unsigned_eq<long4> { typedef ulong4 type; };
+
+template<>
+struct unsigned_eq<int16> { typedef uint16 type; };
+
+template<>
+struct unsigned_eq<long8> { typedef ulong8 type; };
+
 template<typename T>
 using unsigned_eq_t = typename unsigned_eq<T>::type;
 
@@ -388,6 +562,18 @@ struct signed_eq<uint4> { typedef int4 type; };
 template<>
 struct signed_eq<ulong2> { typedef long2 type; };
 
+template<>
+struct signed_eq<uint8> { typedef int8 type; };
+
+template<>
+struct signed_eq<ulong4> { typedef long4 type; };
+
+template<>
+struct signed_eq<uint16> { typedef int16 type; };
+
+template<>
+struct signed_eq<ulong8> { typedef long8 type; };
+
 template<typename T>
 using signed_eq_t = typename signed_eq<T>::type;
 
@@ -459,6 +645,24 @@ inline constexpr auto num_members_v = num_members<T>::value;
 
 static_assert(num_members_v<float> == 1);
 static_assert(num_members_v<float4> == 4);
+static_assert(num_members_v<double4> == 4);
+static_assert(num_members_v<float16> == 16);
+
+/**
+ * @brief The widest floating-point vector types the target has registers for.
+ *
+ * 512-bit with AVX-512, 256-bit with AVX and 128-bit otherwise (SSE, NEON).
+ */
+#if defined(__AVX512F__)
+using native_float_t = float16;
+using native_double_t = double8;
+#elif defined(__AVX__)
+using native_float_t = float8;
+using native_double_t = double4;
+#else
+using native_float_t = float4;
+using native_double_t = double2;
+#endif
 
 /**
  * @brief Get the "true" mask for a floating-point type.
@@ -1,13 +1,147 @@
 #ifndef _vsl_cxm_h
 #define _vsl_cxm_h
 
+#include <array>
 #include <numbers>
+#include <utility>
 
 #include "_vsl_core.h"
 #include "_vsl_utils.h" // select, etc.
 
+namespace vsl {
+
+/**
+ * @brief Accuracy tiers for the cxm approximations: the trig, inverse trig, hyperbolic, exp and log functions, and
+ * the Newton steps of the roots.
+ *
+ * Each tier has its own minimax coefficients, and double gets its own sets for balanced and full. Error bounds are
+ * listed with each function. They're the bounds of the polynomial itself. Evaluation rounding adds a few ULP.
+ */
+enum class Precision {
+    fast,     ///< At least 12 bits, for control-rate signals. Roughly half the work of full.
+    balanced, ///< Float: a few ULP. Double: about 1e-11. (The default.)
+    full      ///< Float and double: within rounding of the polynomial evaluation.
+};
+
+namespace precision {
+
+inline constexpr auto fast = Precision::fast;
+inline constexpr auto balanced = Precision::balanced;
+inline constexpr auto full = Precision::full;
+
+} // namespace precision
+
+/**
+ * @brief How cxm::poly evaluates a polynomial.
+ *
+ * Horner is the shortest sequence of operations. Estrin evaluates pairs of coefficients independently and combines
+ * them with x^2, x^4, ..., which shortens the dependent chain for high degrees.
+ */
+enum class Poly_scheme {
+    horner,
+    estrin
+};
+
+} // namespace vsl
+
 namespace vsl::cxm {
 
+// MARK: - Polynomials
+
+namespace detail {
+
+/// a * b + c, written as one expression on the native vector type so the compiler fuses it into an FMA where the
+/// target has one. (Clang only contracts within a single expression, which the Vec operators would split up.)
+template<typename X>
+force_inline constexpr auto mul_add(X a, X b, X c) -> X
+{
+    if constexpr (is_vector_v<X>) {
+        return X(vsl::detail::native(a) * vsl::detail::native(b) + vsl::detail::native(c));
+    }
+    else {
+        return a * b + c;
+    }
+}
+
+template<typename X, size_t N, size_t... I>
+force_inline constexpr auto coefficients(const std::array<double, N>& c, std::index_sequence<I...>)
+{
+    using S = scalar_t<X>;
+    return std::array<X, N>{X(S(c[I]))...};
+}
+
+template<size_t I = 0, typename X, size_t N>
+force_inline constexpr auto horner(X x, const std::array<X, N>& c) -> X
+{
+    if constexpr (I + 1 == N) {
+        return c[I];
+    }
+    else {
+        return mul_add(detail::horner<I + 1>(x, c), x, c[I]);
+    }
+}
+
+/// One Estrin step: c[2i] + c[2i + 1] * x for each pair, which are the coefficients of a polynomial in x^2.
+template<typename X, size_t N, size_t... I>
+force_inline constexpr auto estrin_pairs(X x, const std::array<X, N>& c, std::index_sequence<I...>)
+{
+    return std::array<X, sizeof...(I)>{(2 * I + 1 < N ? mul_add(c[std::min(2 * I + 1, N - 1)], x, c[2 * I])
+                                                      : c[2 * I])...};
+}
+
+template<typename X, size_t N>
+force_inline constexpr auto estrin(X x, const std::array<X, N>& c) -> X
+{
+    if constexpr (N == 1) {
+        return c[0];
+    }
+    else {
+        return detail::estrin(x * x, detail::estrin_pairs(x, c, std::make_index_sequence<(N + 1) / 2>{}));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Evaluates c[0] + c[1] x + c[2] x^2 + ... Coefficients are rounded to X's scalar type.
+ *
+ * Every step is a multiply-add, fused where the target has FMA. Horner takes one dependent step per coefficient.
+ * Estrin takes about log2 of that (plus the squarings of x, which run alongside), so it wins when the result is on a
+ * dependent chain, for a few more multiplies.
+ */
+template<Poly_scheme Scheme = Poly_scheme::horner, typename X, size_t N>
+force_inline constexpr auto poly(X x, const std::array<double, N>& c) -> X
+{
+    static_assert(N > 0, "A polynomial needs at least one coefficient.");
+
+    const auto cx = detail::coefficients<X>(c, std::make_index_sequence<N>{});
+    if constexpr (Scheme == Poly_scheme::estrin) {
+        return detail::estrin(x, cx);
+    }
+    else {
+        return detail::horner(x, cx);
+    }
+}
+
+/// poly(x, {c0, c...}).
+template<Poly_scheme Scheme = Poly_scheme::horner, typename X, typename... C>
+force_inline constexpr auto poly(X x, double c0, C... c) -> X
+{
+    return cxm::poly<Scheme>(x, std::array<double, sizeof...(C) + 1>{c0, double(c)...});
+}
+
+/// The rational function p(x) / q(x). The two polynomials are independent, so their chains overlap.
+template<Poly_scheme Scheme = Poly_scheme::horner, typename X, size_t N, size_t M>
+force_inline constexpr auto ratio(X x, const std::array<double, N>& p, const std::array<double, M>& q) -> X
+{
+    return cxm::poly<Scheme>(x, p) / cxm::poly<Scheme>(x, q);
+}
+
+static_assert(poly(2, 1.0, 2.0, 3.0) == 17);
+static_assert(poly<Poly_scheme::estrin>(2, 1.0, 2.0, 3.0) == 17);
+static_assert(poly<Poly_scheme::estrin>(-0.5, std::array{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}) == 0.375);
+static_assert(ratio(3.0, std::array{1.0, 1.0}, std::array{2.0}) == 2.0);
+
 // MARK: - Basic
 
 ///
@@ -83,17 +217,22 @@ static_assert(ceil(3.25f) == 4.f);
 static_assert(ceil(-2.1) == -2.0);
 static_assert(ceil(5.f) == 5.f);
 
-///
+/// Rounds halfway cases up. (Compares the fraction with 1/2, since x + 1/2 itself rounds: 0.49999997f + 0.5f == 1.)
 template<typename X>
 force_inline constexpr auto round(X x) -> X 
 {
-    return cxm::floor(x + 0.5f);
+    const auto f = cxm::floor(x);
+    return select(x - f >= X(0.5), f + 1, f);
 }
 
 static_assert(round(1.5) == 2.0);
 static_assert(round(1.49f) == 1.f);
 static_assert(round(-1.5f) == -1.f);
 static_assert(round(-2.9) == -3.0);
+static_assert(round(0.49999997f) == 0.f);
+static_assert(round(0.49999999999999994) == 0.0);
+static_assert(round(-0.49999997f) == 0.f);
+static_assert(round(8388609.f) == 8388609.f);
 
 // MARK: - fmod, wrap
 
@@ -144,220 +283,794 @@ static_assert([]() {
     return abs_equal(wrap(5 * pi, 0.f, 2 * pi), pi);
 }());
 
-// MARK: - Trig Functions
+// MARK: - Reciprocals and roots
 
-///
-template<typename X>
-force_inline constexpr auto cos(X x) -> X
+namespace detail {
+
+/// Newton steps for rcp, rsqrt, sqrt and cbrt. A is a Precision or a number of steps. Each step roughly squares the
+/// relative error of the bit-trick estimate (about 5% for rcp, 3.4% for rsqrt and cbrt).
+template<auto A, typename S, int balanced_double = 3>
+consteval auto newton_steps() -> int
+{
+    if constexpr (std::is_same_v<decltype(A), Precision>) {
+        if constexpr (A == Precision::fast) {
+            return 2;
+        }
+        else if constexpr (sizeof(S) == 4) {
+            return 3;
+        }
+        else {
+            return A == Precision::balanced ? balanced_double : 4;
+        }
+    }
+    else {
+        static_assert(A >= 0, "The number of Newton steps can't be negative");
+        return static_cast<int>(A);
+    }
+}
+
+/// n / 3 with shifts and adds, since there is no vector integer divide (Hacker's Delight, divu3). Exact for n < 2^63.
+template<typename U>
+force_inline constexpr auto div3(U n) -> U
 {
-    constexpr auto c0 = X(9.99999991e-01);
-    constexpr auto c2 = X(-4.99999934e-01);
-    constexpr auto c4 = X(4.16665646e-02);
-    constexpr auto c6 = X(-1.38882256e-03);
-    constexpr auto c8 = X(2.47799311e-05);
-    constexpr auto c10 = X(-2.71853320e-07);
-    constexpr auto c12 = X(1.76564052e-09);
+    using S = scalar_t<U>;
+    auto q = (n >> 2) + (n >> 4);
+    q += q >> 4;
+    q += q >> 8;
+    q += q >> 16;
+    if constexpr (sizeof(S) == 8) {
+        q += q >> 32;
+    }
+    const auto r = n - (q + (q << 1));
+    return q + ((r + (r << 1) + (r << 3)) >> 5);
+}
 
-    const auto x2 = x * x;
+static_assert(div3(0u) == 0u);
+static_assert(div3(2147483647u) == 715827882u);
+static_assert(div3(9223372036854775807ul) == 3074457345618258602ul);
 
-    return c0 + x2 * (c2 + x2 * (c4 + x2 * (c6 + x2 * (c8 + x2 * (c10 + x2 * c12)))));
+/// Bit-trick estimates (magic constant minus the scaled bit pattern), for positive x. The constants minimize the
+/// largest relative error over a binade.
+template<typename X>
+force_inline constexpr auto rcp_estimate(X x) -> X
+{
+    using S = scalar_t<X>;
+    using U = uint_t<S>;
+    constexpr auto magic = sizeof(S) == 4 ? U(0x7ef311c2) : U(0x7fde623855500000);
+    return reinterpret_as_float(magic - reinterpret_as_int(x));
 }
 
-static_assert(abs_equal(cos(0.f), 1.f));
+template<typename X>
+force_inline constexpr auto rsqrt_estimate(X x) -> X
+{
+    using S = scalar_t<X>;
+    using U = uint_t<S>;
+    constexpr auto magic = sizeof(S) == 4 ? U(0x5f376423) : U(0x5fe6ec7bbd300000);
+    return reinterpret_as_float(magic - (reinterpret_as_int(x) >> 1));
+}
 
-///
 template<typename X>
-force_inline constexpr auto sin(X x) -> X
+force_inline constexpr auto rcbrt_estimate(X x) -> X
 {
-    constexpr auto c1 = X(9.99999737e-01);
-    constexpr auto c3 = X(-1.66665387e-01);
-    constexpr auto c5 = X(8.33221031e-03);
-    constexpr auto c7 = X(-1.98027220e-04);
-    constexpr auto c9 = X(2.69284266e-06);
-    constexpr auto c11 = X(-2.00882849e-08);
+    using S = scalar_t<X>;
+    using U = uint_t<S>;
+    constexpr auto magic = sizeof(S) == 4 ? U(0x54a232a3) : U(0x553ef0fb54eaa800);
+    return reinterpret_as_float(magic - div3(reinterpret_as_int(x)));
+}
 
-    const auto x2 = x * x;
+/// 1 / sqrt(x) for positive x.
+template<int Steps, typename X>
+force_inline constexpr auto rsqrt(X x) -> X
+{
+    auto y = rsqrt_estimate(x);
+    const auto half_x = X(0.5) * x;
+    for (auto i = 0; i < Steps; ++i) {
+        y = y * mul_add(-half_x * y, y, X(1.5));
+    }
+    return y;
+}
+
+} // namespace detail
+
+/**
+ * @brief 1 / x, from a bit-trick estimate and Newton steps.
+ *
+ * A is a Precision or an explicit number of steps. Fast: 2 steps, 6e-6 relative error. Balanced: 3 steps (float: 1
+ * ULP, double: 4e-11). Full: 3 steps for float, 4 for double (1 ULP). x and 1 / x must be normal (not 0, inf or
+ * subnormal).
+ */
+template<auto A = Precision::balanced, typename X>
+force_inline constexpr auto rcp(X x) -> X
+{
+    constexpr auto steps = detail::newton_steps<A, scalar_t<X>>();
+    // The estimate is built from |x|, which is exact, and the steps work on signed x.
+    auto y = detail::rcp_estimate(cxm::abs(x));
+    y = select(x < 0, -y, y);
+    for (auto i = 0; i < steps; ++i) {
+        y = detail::mul_add(y, detail::mul_add(-x, y, X(1)), y);
+    }
+    return y;
+}
 
-    return x * (c1 + x2 * (c3 + x2 * (c5 + x2 * (c7 + x2 * (c9 + x2 * c11)))));
+static_assert(rcp(4.f) == 0.25f);
+static_assert(rcp<Precision::full>(-3.0) == 1 / -3.0);
+static_assert(rel_equal(rcp<Precision::fast>(7.f), 1 / 7.f, 1e-5f));
+static_assert(rel_equal(rcp<1>(7.f), 1 / 7.f, 3e-3f));
+
+/**
+ * @brief 1 / sqrt(x), from a bit-trick estimate and Newton steps.
+ *
+ * Steps as for rcp. Fast: 5e-6 relative error. Balanced: 2 ULP for float, 3e-11 for double. Full: 2 ULP. x must be
+ * positive and normal.
+ */
+template<auto A = Precision::balanced, typename X>
+force_inline constexpr auto rsqrt(X x) -> X
+{
+    return detail::rsqrt<detail::newton_steps<A, scalar_t<X>>()>(x);
 }
 
-static_assert(abs_equal(sin(0.f), 0.f));
+static_assert(rsqrt(4.f) == 0.5f);
+static_assert(rsqrt<Precision::full>(2.0) == 1 / std::numbers::sqrt2);
+
+/**
+ * @brief sqrt(x) as x * rsqrt(x), with the last Newton step applied to the square root itself, which rounds better.
+ *
+ * Steps as for rcp. Fast: 5e-6 relative error. Balanced: 1 ULP for float, 3e-11 for double. Full: 1 ULP. x must be 0
+ * or positive and normal.
+ */
+template<auto A = Precision::balanced, typename X>
+force_inline constexpr auto sqrt(X x) -> X
+{
+    constexpr auto steps = detail::newton_steps<A, scalar_t<X>>();
+    if constexpr (steps == 0) {
+        return x * detail::rsqrt_estimate(x);
+    }
+    else {
+        const auto y = detail::rsqrt<steps - 1>(x);
+        const auto s = x * y;
+        return detail::mul_add(X(0.5) * y, detail::mul_add(-s, s, x), s);
+    }
+}
 
-///
+static_assert(sqrt(0.f) == 0.f);
+static_assert(sqrt(16.f) == 4.f);
+static_assert(sqrt<Precision::full>(2.0) == std::numbers::sqrt2);
+static_assert(rel_equal(sqrt<Precision::fast>(1e10f), 1e5f, 1e-5f));
+
+/**
+ * @brief cbrt(x) as x / cbrt(x)^2, from a bit-trick estimate of 1 / cbrt(|x|) and Newton steps. The last step is
+ * applied to the cube root itself, as in sqrt.
+ *
+ * Fast: 2 steps, 5e-5 relative error. Balanced and full: 3 steps for float, 4 for double (1 ULP).
+ * x must be 0 or normal.
+ */
+template<auto A = Precision::balanced, typename X>
+force_inline constexpr auto cbrt(X x) -> X
+{
+    using S = scalar_t<X>;
+    constexpr auto steps = detail::newton_steps<A, S, 4>();
+    const auto a = cxm::abs(x);
+    auto r = detail::rcbrt_estimate(a);
+    for (auto i = 0; i < steps - 1; ++i) {
+        const auto e = detail::mul_add(-a * r, r * r, X(1));
+        r = detail::mul_add(r * X(S(1) / 3), e, r);
+    }
+    const auto r2 = r * r;
+    const auto c = x * r2;
+    if constexpr (steps == 0) {
+        return c;
+    }
+    else {
+        return detail::mul_add(r2 * X(S(1) / 3), detail::mul_add(-c * c, c, x), c);
+    }
+}
+
+static_assert(cbrt(0.f) == 0.f);
+static_assert(rel_equal(cbrt(27.f), 3.f));
+static_assert(rel_equal(cbrt(-8.0), -2.0, 1e-15));
+static_assert(rel_equal(cbrt<Precision::fast>(1e-6f), 1e-2f, 5e-5f));
+
+/**
+ * @brief sqrt(x^2 + y^2), like std::hypot, with cxm::sqrt.
+ *
+ * x and y are scaled by the same power of 2, which is exact, to bring the larger one near 1, so the squares can't
+ * overflow or underflow. Errors as for sqrt, plus rounding of the sum of squares. Infinite if x or y is.
+ */
+template<auto A = Precision::balanced, typename X>
+force_inline constexpr auto hypot(X x, X y) -> X
+{
+    using S = scalar_t<X>;
+    using U = uint_t<S>;
+    constexpr auto exp_bias = ieee_exp_bias_v<S>;
+    constexpr auto sig_bits = ieee_sig_bits_v<S>;
+    constexpr auto exp_mask = U(2 * exp_bias + 1) << sig_bits;
+
+    // The exponent field of the larger magnitude, kept to normal numbers whose reciprocals are normal too.
+    constexpr auto e_lo = U(1) << sig_bits;
+    constexpr auto e_hi = U(2 * exp_bias - 1) << sig_bits;
+    const auto ax = cxm::abs(x);
+    const auto ay = cxm::abs(y);
+    const auto e_max = reinterpret_as_int(select(ax > ay, ax, ay)) & exp_mask;
+    const auto e = select(e_max < e_lo, decltype(e_max)(e_lo), select(e_max > e_hi, decltype(e_max)(e_hi), e_max));
+    const auto scale = reinterpret_as_float((U(2 * exp_bias) << sig_bits) - e);
+
+    const auto sx = x * scale;
+    const auto sy = y * scale;
+    const auto h = cxm::sqrt<A>(detail::mul_add(sx, sx, sy * sy)) * reinterpret_as_float(e);
+    return select(e_max == exp_mask, ax + ay, h); // inf or NaN
+}
+
+static_assert(hypot(0.f, 0.f) == 0.f);
+static_assert(hypot(3.f, -4.f) == 5.f);
+static_assert(hypot<Precision::full>(3e300, 4e300) == 5e300);
+static_assert(rel_equal(hypot(3e-30f, 4e-30f), 5e-30f, 1e-6f));
+
+// MARK: - Trig Functions
+
+/// A sine and cosine, as returned by sincos.
 template<typename X>
-force_inline constexpr auto tan(X x) -> X
+struct Sin_cos {
+    X sin;
+    X cos;
+};
+
+namespace detail {
+
+// The balanced double polynomials use Estrin's scheme, which cuts their latency by about 30% (see the poly_12 rows
+// of vsl-bench) at some cost in throughput. Full stays on Horner, which rounds less.
+
+/// Minimax approximations of cos(r) on -pi/4...pi/4, as polynomials in r^2.
+template<Precision P, typename X>
+force_inline constexpr auto cos_poly(X r2) -> X
 {
-    constexpr auto a1 = X(1);
-    constexpr auto a3 = X(-5 / 39.0);
-    constexpr auto a5 = X(2 / 715.0);
-    constexpr auto a7 = X(-1 / 135135.0);
-    constexpr auto b0 = X(1);
-    constexpr auto b2 = X(-6 / 13.0);
-    constexpr auto b4 = X(10 / 429.0);
-    constexpr auto b6 = X(-4 / 19305.0);
+    using S = scalar_t<X>;
 
-    const auto x2 = x * x;
+    // max relative error 1.2e-5
+    if constexpr (P == Precision::fast) {
+        return poly(r2, 0.999988217, -0.499685485, 0.0403622939);
+    }
+    // max relative error 3.3e-8
+    else if constexpr (P == Precision::balanced && sizeof(S) == 4) {
+        return poly(r2, 0.99999996738628658, -0.49999842434213032, 0.041654419561764116, -0.0013579404079726883);
+    }
+    // max relative error 5.6e-11 (float full is the same)
+    else if constexpr (P == Precision::balanced || sizeof(S) == 4) {
+        return poly(r2, 0.99999999994393732, -0.49999999571556858, 0.041666613233473632, -0.0013886529147145679,
+                    2.4372679177223422e-5);
+    }
+    // max relative error 3.6e-20
+    else {
+        return poly(r2, 1.0, -0.49999999999999999, 0.04166666666666643, -0.001388888888885896, 2.4801587282899464e-5,
+                    -2.755731286569637e-7, 2.0875555145712735e-9, -1.1352123207581e-11);
+    }
+}
 
-    const auto numer = x * (a1 + x2 * (a3 + x2 * (a5 + x2 * a7)));
-    const auto denom = b0 + x2 * (b2 + x2 * (b4 + x2 * b6));
+/// Minimax approximations of sin(r) / r on -pi/4...pi/4, as polynomials in r^2.
+template<Precision P, typename X>
+force_inline constexpr auto sin_poly(X r2) -> X
+{
+    using S = scalar_t<X>;
 
-    return numer / denom;
+    // max relative error 1.5e-6
+    if constexpr (P == Precision::fast) {
+        return poly(r2, 0.999998493, -0.166623823, 0.00815005656);
+    }
+    // max relative error 3.2e-9 (float full is the same)
+    else if constexpr (sizeof(S) == 4) {
+        return poly(r2, 0.99999999676179806, -0.16666650224239648, 0.0083320164530660007, -0.00019501822013901903);
+    }
+    // max relative error 4.6e-12
+    else if constexpr (P == Precision::balanced) {
+        return poly(r2, 0.99999999999545035, -0.16666666630446179, 0.0083333286901520303, -0.0001983917835587654,
+                    2.7171528105110005e-6);
+    }
+    // max relative error 3.3e-18
+    else {
+        return poly(r2, 1.0, -0.16666666666666615, 0.0083333333333200024, -0.0001984126982840213, 2.7557313299015092e-6,
+                    -2.5050705846384202e-8, 1.5894136372244073e-10);
+    }
 }
 
-static_assert(abs_equal(tan(0.f), 0.f));
+/// Minimax approximations of sin(r) / r on -pi/2...pi/2, as polynomials in r^2. Used by sin and cos alone, which
+/// reduce by pi and need only this one polynomial.
+template<Precision P, typename X>
+force_inline constexpr auto sin_half_pi_poly(X r2) -> X
+{
+    using S = scalar_t<X>;
 
-// MARK: - Inverse Trig Functions
+    // max relative error 1.1e-4
+    if constexpr (P == Precision::fast) {
+        return poly(r2, 0.999891821, -0.165960117, 0.00760290334);
+    }
+    // max relative error 5.3e-9 (float full is the same)
+    else if constexpr (sizeof(S) == 4) {
+        return poly(r2, 0.99999999468600734, -0.16666656684007151, 0.0083330251389693672, -0.00019807418727426961,
+                    2.6019030676514354e-6);
+    }
+    // max relative error 6.2e-14
+    else if constexpr (P == Precision::balanced) {
+        return poly<Poly_scheme::estrin>(r2, 0.99999999999993756, -0.16666666666432331, 0.008333333318765514,
+                                         -0.0001984126641162215, 2.7556931926594907e-6, -2.5029518865603179e-8,
+                                         1.5401170371414255e-10);
+    }
+    // max relative error 2.6e-19
+    else {
+        return poly(r2, 1.0, -0.16666666666666665, 0.008333333333333165, -0.0001984126984120184, 2.7557319210152756e-6,
+                    -2.5052106798274615e-8, 1.6058936490373223e-10, -7.6429178069369361e-13, 2.7204790963112761e-15);
+    }
+}
 
+/// An argument reduced to r in -pi/4...pi/4, where the original is r + quadrant * pi/2. (Only quadrant's low bits
+/// are meaningful.)
+template<typename X>
+struct Reduced {
+    X r;
+    uint_t<X> quadrant;
+};
+
+/// Rounds x to the nearest integer k, for |x| < 2^(sig_bits - 1). k's low bits are also returned as an integer.
 ///
+/// Adding 1.5 * 2^sig_bits pushes the fraction out of the significand, which is cheaper than cxm::round and
+/// leaves k in the low bits of the sum.
 template<typename X>
-force_inline constexpr auto asin(X x) -> X
+force_inline constexpr auto round_with_bits(X x, X& k) -> uint_t<X>
 {
-    constexpr auto a1 = X(1);
-    constexpr auto a3 = X(-1.27636876);
-    constexpr auto a5 = X(0.3993034);
-    constexpr auto a7 = X(-0.01937842);
-    constexpr auto b0 = X(1);
-    constexpr auto b2 = X(-1.44303543);
-    constexpr auto b4 = X(0.56480931);
-    constexpr auto b6 = X(-0.04992851);
+    using S = scalar_t<X>;
+    constexpr auto one = uint_t<S>{1};
+    constexpr auto magic = S(1.5) * static_cast<S>(one << ieee_sig_bits_v<S>);
 
-    const auto x2 = x * x;
-    
-    const auto numer = x * (a1 + x2 * (a3 + x2 * (a5 + x2 * a7)));
-    const auto denom = b0 + x2 * (b2 + x2 * (b4 + x2 * b6));
-    
-    return numer / denom;
+    const auto sum = x + magic;
+    k = sum - magic;
+    return reinterpret_as_int(sum);
 }
 
-static_assert(abs_equal(asin(0.f), 0.f));
+/**
+ * @brief Cody-Waite reduction: x - k * pi/2, for integral k.
+ *
+ * pi/2 is split into parts short enough that k * part is exact, so the result is accurate while |k| is below
+ * 2^12 for float (|x| < 6433) and 2^20 for double (|x| < 1.6e6). Past that the error grows with |x|.
+ */
+template<typename X>
+force_inline constexpr auto sub_half_pi(X x, X k) -> X
+{
+    using S = scalar_t<X>;
 
-///
+    if constexpr (sizeof(S) == 4) {
+        // 12 + 12 + 24 bits
+        return ((x - k * X(1.57080078125f)) - k * X(-4.45358455e-6f)) - k * X(-8.70551575e-10f);
+    }
+    else {
+        // 33 + 33 + 33 + 53 bits (fdlibm's split)
+        return (((x - k * X(1.57079632673412561417e+00)) - k * X(6.07710050630396597660e-11))
+                - k * X(2.02226624871116645580e-21)) - k * X(8.47842766036889956997e-32);
+    }
+}
+
+/// Reduction of x by pi/2. See sub_half_pi for the range where it's accurate.
 template<typename X>
-force_inline constexpr auto acos(X x) -> X
+force_inline constexpr auto reduce_half_pi(X x) -> Reduced<X>
 {
     using S = scalar_t<X>;
-    return X(std::numbers::pi_v<S> / 2) - cxm::asin(x);
+    auto k = X(0);
+    const auto quadrant = detail::round_with_bits(x * X(2 / std::numbers::pi_v<S>), k);
+    return {detail::sub_half_pi(x, k), quadrant};
 }
 
-static_assert(abs_equal(acos(0.f), std::numbers::pi_v<float> / 2));
+/// x with its sign flipped where bit 0 of odd is set.
+template<typename X>
+force_inline constexpr auto negate_if_odd(X x, uint_t<X> odd) -> X
+{
+    using S = scalar_t<X>;
+    constexpr auto sign_shift = uint_t<S>{sizeof(S) * 8 - 1};
+    return reinterpret_as_float(reinterpret_as_int(x) ^ ((odd & 1) << sign_shift));
+}
 
-///
+/// Reduction of a normalized phase (in turns) by a quarter turn. This one is exact.
 template<typename X>
-force_inline constexpr auto atan(X x) -> X
+force_inline constexpr auto reduce_quarter_turn(X p) -> Reduced<X>
 {
-    constexpr auto a1 = X(1);
-    constexpr auto a3 = X(1.28205128);
-    constexpr auto a5 = X(0.3958042);
-    constexpr auto a7 = X(0.01704962);
-    constexpr auto b0 = X(1);
-    constexpr auto b2 = X(1.61538462);
-    constexpr auto b4 = X(0.73426573);
-    constexpr auto b6 = X(0.08158508);
+    using S = scalar_t<X>;
+    auto k = X(0);
+    const auto quadrant = detail::round_with_bits(p * 4, k);
+    const auto r = (p - k * S(0.25)) * X(2 * std::numbers::pi_v<S>);
+    return {r, quadrant};
+}
 
-    const auto x2 = x * x;
-    
-    const auto numer = x * (a1 + x2 * (a3 + x2 * (a5 + x2 * a7)));
-    const auto denom = b0 + x2 * (b2 + x2 * (b4 + x2 * b6));
-    
-    return numer / denom;
+/// sin and cos of a reduced argument, rotated back to its quadrant.
+template<Precision P, typename X>
+force_inline constexpr auto sincos_reduced(Reduced<X> a) -> Sin_cos<X>
+{
+    const auto r2 = a.r * a.r;
+    const auto s = a.r * detail::sin_poly<P>(r2);
+    const auto c = detail::cos_poly<P>(r2);
+
+    const auto q = a.quadrant;
+    const auto swap = (q & 1) != 0;
+    const auto sin_r = select(swap, c, s);
+    const auto cos_r = select(swap, s, c);
+
+    return {detail::negate_if_odd(sin_r, q >> 1), detail::negate_if_odd(cos_r, (q + 1) >> 1)};
 }
 
-static_assert(abs_equal(atan(0.f), 0.f));
+} // namespace detail
 
-// MARK: - Hyperbolic Trig Functions
+/**
+ * @brief sin(x) and cos(x) from one range reduction.
+ *
+ * The argument is reduced by pi/2 (see detail::reduce_half_pi for the range where that's exact) and both values
+ * come from polynomials on -pi/4...pi/4. The error bounds listed in detail::cos_poly and sin_poly are relative.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto sincos(X x) -> Sin_cos<X>
+{
+    return detail::sincos_reduced<P>(detail::reduce_half_pi(x));
+}
 
-///
-template<typename X>
-force_inline constexpr auto cosh(X x) -> X
+/**
+ * @brief cos(x).
+ *
+ * Reduced by pi around the odd multiples of pi/2, so a single sin polynomial on -pi/2...pi/2 covers every lane;
+ * that's cheaper than sincos when only one value is needed. The range is as for sincos.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto cos(X x) -> X
 {
-    constexpr auto a0 = X(1);
-    constexpr auto a2 = X(3665 / 7788.0);
-    constexpr auto a4 = X(711 / 25960.0);
-    constexpr auto a6 = X(301 / 808396.0);
-    constexpr auto b0 = X(1);
-    constexpr auto b2 = X(-229 / 7788.0);
-    constexpr auto b4 = X(1 / 2360.0);
-    constexpr auto b6 = X(-1 / 309067.0);
+    using S = scalar_t<X>;
 
-    const auto x2 = x * x;
+    // x = (n + 1/2) pi + r, and cos(x) = -(-1)^n sin(r)
+    auto n = X(0);
+    const auto n_bits = detail::round_with_bits(x * X(1 / std::numbers::pi_v<S>) - X(0.5), n);
+    const auto r = detail::sub_half_pi(x, n * 2 + 1);
+    return detail::negate_if_odd(r * detail::sin_half_pi_poly<P>(r * r), n_bits + 1);
+}
+
+static_assert(abs_equal(cos(0.f), 1.f, 2e-7f));
+static_assert(abs_equal(cos(100.f), 0.86231887f, 1e-6f));
+static_assert(abs_equal(cos<precision::fast>(2.f), -0.41614684f, 1e-4f));
+static_assert(abs_equal(cos<precision::full>(2.0), -0.41614683654714241, 1e-15));
+static_assert(abs_equal(cos<precision::full>(1e5), -0.99936080743821240, 1e-12));
+
+/// sin(x). Reduced by pi, like cos.
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto sin(X x) -> X
+{
+    using S = scalar_t<X>;
 
-    const auto numer = a0 + x2 * (a2 + x2 * (a4 + x2 * a6));
-    const auto denom = b0 + x2 * (b2 + x2 * (b4 + x2 * b6));
+    // x = n pi + r, and sin(x) = (-1)^n sin(r)
+    auto n = X(0);
+    const auto n_bits = detail::round_with_bits(x * X(1 / std::numbers::pi_v<S>), n);
+    const auto r = detail::sub_half_pi(x, n * 2);
+    return detail::negate_if_odd(r * detail::sin_half_pi_poly<P>(r * r), n_bits);
+}
 
-    return numer / denom;
+static_assert(abs_equal(sin(0.f), 0.f));
+static_assert(abs_equal(sin(-100.f), 0.50636564f, 1e-6f));
+static_assert(abs_equal(sin<precision::fast>(2.f), 0.90929743f, 1e-4f));
+static_assert(abs_equal(sin<precision::full>(2.0), 0.90929742682568170, 1e-15));
+
+/**
+ * @brief sin(2 pi p) and cos(2 pi p) for a phase p in turns, e.g. an oscillator phase in 0...1.
+ *
+ * The quarter-turn reduction is exact, so any p works, and the result is as accurate as p itself.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto sincos_phase(X p) -> Sin_cos<X>
+{
+    return detail::sincos_reduced<P>(detail::reduce_quarter_turn(p));
 }
 
-///
-template<typename X>
-force_inline constexpr auto sinh(X x) -> X
+/// cos(2 pi p) for a phase p in turns.
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto cos_phase(X p) -> X
 {
-    constexpr auto a1 = X(1);
-    constexpr auto a3 = X(29593 / 207636.0);
-    constexpr auto a5 = X(1911 / 416747.0);
-    constexpr auto a7 = X(13 / 312254.0);
-    constexpr auto b0 = X(1);
-    constexpr auto b2 = X(-1671 / 69212.0);
-    constexpr auto b4 = X(97 / 351384.0);
-    constexpr auto b6 = X(-1 / 626945.0);
+    return cxm::sincos_phase<P>(p).cos;
+}
 
-    const auto x2 = x * x;
+static_assert(cos_phase(0.25f) == 0.f);
+static_assert(abs_equal(cos_phase(0.5), -1.0, 1e-10));
+static_assert(abs_equal(cos_phase(0.125f), std::numbers::sqrt2_v<float> / 2));
 
-    const auto numer = x * (a1 + x2 * (a3 + x2 * (a5 + x2 * a7)));
-    const auto denom = b0 + x2 * (b2 + x2 * (b4 + x2 * b6));
+/// sin(2 pi p) for a phase p in turns.
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto sin_phase(X p) -> X
+{
+    return cxm::sincos_phase<P>(p).sin;
+}
+
+static_assert(sin_phase(0.f) == 0.f);
+static_assert(abs_equal(sin_phase(0.75), -1.0, 1e-10));
+static_assert(abs_equal(sin_phase<precision::full>(0.1), 0.58778525229247314, 1e-15));
 
-    return numer / denom;
+/**
+ * @brief tan(x) as sin(x) / cos(x), from sincos.
+ *
+ * Relative error: fast 3e-5, balanced 4 ULP (float) or 6e-11 (double), full 3 ULP, over the range of sincos.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto tan(X x) -> X
+{
+    const auto [s, c] = cxm::sincos<P>(x);
+    return s / c;
 }
 
-///
+static_assert(tan(0.f) == 0.f);
+static_assert(rel_equal(tan(1.5f), 14.101420f, 1e-6f));
+static_assert(rel_equal(tan<precision::full>(-1.0), -1.5574077246549023, 1e-15));
+
+// MARK: - Inverse Trig Functions
+
+namespace detail {
+
+/// x with the sign bit of s flipped into it: copysign(x, s) for x >= 0.
 template<typename X>
-force_inline constexpr auto tanh(X x) -> X
+force_inline constexpr auto xor_sign(X x, X s) -> X
+{
+    using S = scalar_t<X>;
+    constexpr auto sign_mask = uint_t<S>{1} << (sizeof(S) * 8 - 1);
+    return reinterpret_as_float(reinterpret_as_int(x) ^ (reinterpret_as_int(s) & sign_mask));
+}
+
+/// Minimax approximations of asin(s) on 0...1/2, as s * p(z), where z = s^2.
+template<Precision P, typename X>
+force_inline constexpr auto asin_poly(X s, X z) -> X
+{
+    using S = scalar_t<X>;
+
+    // max relative error 3.1e-5
+    if constexpr (P == Precision::fast) {
+        return s * poly(z, 1.0000310595, 0.1645388076, 0.09598822866);
+    }
+    // max relative error 8.0e-8
+    else if constexpr (P == Precision::balanced && sizeof(S) == 4) {
+        return s * poly(z, 1.000000080, 0.1666513018, 0.07547153330, 0.03967789161, 0.05059202712);
+    }
+    // max relative error 1.5e-11
+    else if constexpr (P == Precision::balanced) {
+        return s * poly<Poly_scheme::estrin>(z, 0.99999999998490314331, 0.16666667421674325364,
+                                             0.074999381985602644744, 0.044662035666504264002,
+                                             0.030092207834387333325, 0.024711551303599710492,
+                                             0.007223802985324880852, 0.034951583521054059499);
+    }
+    // max relative error 4.4e-9
+    else if constexpr (P == Precision::full && sizeof(S) == 4) {
+        return s * poly(z, 0.99999999558, 0.1666679011, 0.07494434760, 0.04555018534, 0.02385816935,
+                        0.04263564225);
+    }
+    // max relative error 1.4e-17
+    else {
+        return s * poly(z, 1.0000000000000000142, 0.1666666666666477032, 0.075000000004179691983,
+                        0.044642856781408867566, 0.030381960650348297619, 0.022371727970408393394,
+                        0.017360094637399267535, 0.013881842857547973362, 0.012189191155582474814,
+                        0.0064494049665796358068, 0.019725888833224781991, -0.01651175398854918856,
+                        0.032096274482812388572);
+    }
+}
+
+/// asin(|x|) = r above 1/2 (far), where r = asin(sqrt((1 - |x|) / 2)) and asin(|x|) = pi/2 - 2 r.
+template<typename X>
+struct Asin_reduced {
+    X r;
+    decltype(X{} > X{}) far;
+};
+
+template<Precision P, typename X>
+force_inline constexpr auto asin_reduced(X x) -> Asin_reduced<X>
+{
+    // The reduction's sqrt is on the critical path of the error, so balanced takes the full tier's extra step.
+    constexpr auto root = P == Precision::fast ? Precision::fast : Precision::full;
+    const auto a = cxm::abs(x);
+    const auto far = a > X(0.5);
+    const auto z = select(far, (X(1) - a) * X(0.5), a * a);
+    const auto s = select(far, cxm::sqrt<root>(z), a);
+    return {asin_poly<P>(s, z), far};
+}
+
+} // namespace detail
+
+/**
+ * @brief asin(x) for x in -1...1, from a polynomial on |x| <= 1/2 and asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2))
+ * above, without branches.
+ *
+ * Relative error: fast 7e-5, balanced 4 ULP (float) or 3e-11 (double), full 3 ULP. Likewise for acos.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto asin(X x) -> X
 {
-    constexpr auto a1 = X(1);
-    constexpr auto a3 = X(5 / 39.0);
-    constexpr auto a5 = X(2 / 715.0);
-    constexpr auto a7 = X(1 / 135135.0);
-    constexpr auto b0 = X(1);
-    constexpr auto b2 = X(6 / 13.0);
-    constexpr auto b4 = X(10 / 429.0);
-    constexpr auto b6 = X(4 / 19305.0);
+    using S = scalar_t<X>;
+    const auto [r, far] = detail::asin_reduced<P>(x);
+    return detail::xor_sign(select(far, X(std::numbers::pi_v<S> / 2) - X(2) * r, r), x);
+}
+
+static_assert(asin(0.f) == 0.f);
+static_assert(asin(1.f) == std::numbers::pi_v<float> / 2);
+static_assert(rel_equal(asin(-0.5f), -std::numbers::pi_v<float> / 6, 1e-6f));
+static_assert(rel_equal(asin<precision::full>(0.9), 1.1197695149986342, 1e-15));
 
+/// acos(x) for x in -1...1, with the reduction of asin. acos(x) = 2 r above 1/2 and pi - 2 r below -1/2.
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto acos(X x) -> X
+{
+    using S = scalar_t<X>;
+    constexpr auto pi = std::numbers::pi_v<S>;
+    const auto [r, far] = detail::asin_reduced<P>(x);
+    const auto far_acos = select(x < 0, X(pi) - X(2) * r, X(2) * r);
+    return select(far, far_acos, X(pi / 2) - detail::xor_sign(r, x));
+}
+
+static_assert(acos(1.f) == 0.f);
+static_assert(acos(-1.f) == std::numbers::pi_v<float>);
+static_assert(rel_equal(acos(0.f), std::numbers::pi_v<float> / 2, 1e-7f));
+static_assert(rel_equal(acos<precision::full>(0.9), 0.45102681179626243, 1e-15));
+
+namespace detail {
+
+/// Minimax approximations of atan(x) on -tan(pi/8)...tan(pi/8), as x * p(x^2).
+template<Precision P, typename X>
+force_inline constexpr auto atan_poly(X x) -> X
+{
+    using S = scalar_t<X>;
     const auto x2 = x * x;
 
-    const auto numer = x * (a1 + x2 * (a3 + x2 * (a5 + x2 * a7)));
-    const auto denom = b0 + x2 * (b2 + x2 * (b4 + x2 * b6));
+    // max relative error 1.8e-5
+    if constexpr (P == Precision::fast) {
+        return x * poly(x2, 0.9999819779, -0.3313906791, 0.1682293155);
+    }
+    // max relative error 5.6e-7
+    else if constexpr (P == Precision::balanced && sizeof(S) == 4) {
+        return x * poly(x2, 0.9999994445, -0.3332274751, 0.1968109416, -0.1111344353);
+    }
+    // max relative error 2.1e-11
+    else if constexpr (P == Precision::balanced) {
+        return x * poly<Poly_scheme::estrin>(x2, 0.99999999997929772329, -0.33333332134955455906,
+                                             0.19999886378096354776, -0.14281651149123000458, 0.11041187524945963703,
+                                             -0.084597989369261675127, 0.047143355122355253263);
+    }
+    // max relative error 1.8e-8
+    else if constexpr (P == Precision::full && sizeof(S) == 4) {
+        return x * poly(x2, 0.999999982, -0.3333279919, 0.1997447036, -0.1385208828, 0.07986736694);
+    }
+    // max relative error 3.3e-17
+    else {
+        return x * poly(x2, 0.99999999999999996686, -0.33333333333328616812, 0.1999999999888921419,
+                        -0.14285714183509802583, 0.11111106276082882571, -0.090907751491622506778,
+                        0.076899809006853130432, -0.066404580742977830258, 0.05689457395277884401,
+                        -0.043510861612960469313, 0.021170681991802757541);
+    }
+}
+
+/// atan(num / den) + offset, for the octant reduction shared by atan and atan2. With num / den in
+/// -tan(pi/8)...tan(pi/8), this is the only divide.
+template<Precision P, typename X>
+force_inline constexpr auto atan_reduced(X num, X den, X offset) -> X
+{
+    return offset + atan_poly<P>(num / den);
+}
+
+} // namespace detail
 
-    return numer / denom;
+/**
+ * @brief atan(x), reduced to |x| <= tan(pi/8) with atan(x) = pi/4 + atan((x - 1) / (x + 1)) and
+ * atan(x) = pi/2 - atan(1 / x), without branches.
+ *
+ * Relative error: fast 4e-5, balanced 1e-6 (float) or 2.1e-11 (double), full 2 ULP. Likewise for atan2.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto atan(X x) -> X
+{
+    using S = scalar_t<X>;
+    constexpr auto tan_pi_8 = std::numbers::sqrt2_v<S> - 1;
+    constexpr auto tan_3pi_8 = std::numbers::sqrt2_v<S> + 1;
+    constexpr auto pi = std::numbers::pi_v<S>;
+
+    const auto a = cxm::abs(x);
+    const auto mid = a > tan_pi_8;
+    const auto high = a > tan_3pi_8;
+    const auto num = select(high, X(-1), select(mid, a - 1, a));
+    const auto den = select(high, a, select(mid, a + 1, X(1)));
+    const auto offset = select(high, X(pi / 2), select(mid, X(pi / 4), X(0)));
+    return detail::xor_sign(detail::atan_reduced<P>(num, den, offset), x);
 }
 
+static_assert(atan(0.f) == 0.f);
+static_assert(rel_equal(atan(1.f), std::numbers::pi_v<float> / 4, 1e-6f));
+static_assert(rel_equal(atan(-1e30), -std::numbers::pi / 2, 1e-15));
+
+/**
+ * @brief The angle of (x, y) in -pi...pi, like std::atan2, with the octant reduction of atan on min(|x|, |y|) and
+ * max(|x|, |y|), and no branches.
+ *
+ * Signed zeros give the same results as std::atan2 (e.g. atan2(+0, -0) = pi). x and y can't both be infinite.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto atan2(X y, X x) -> X
+{
+    using S = scalar_t<X>;
+    constexpr auto tan_pi_8 = std::numbers::sqrt2_v<S> - 1;
+    constexpr auto tan_3pi_8 = std::numbers::sqrt2_v<S> + 1;
+    constexpr auto pi = std::numbers::pi_v<S>;
+    constexpr auto sign_shift = uint_t<S>{sizeof(S) * 8 - 1};
+
+    // The angle of (|x|, |y|) in the first quadrant.
+    const auto ax = cxm::abs(x);
+    const auto ay = cxm::abs(y);
+    const auto mid = ay > tan_pi_8 * ax;
+    const auto high = ay > tan_3pi_8 * ax;
+    const auto num = select(high, -ax, select(mid, ay - ax, ay));
+    const auto den = select(high, ay, select(mid, ay + ax, ax));
+    const auto offset = select(high, X(pi / 2), select(mid, X(pi / 4), X(0)));
+    const auto r = detail::atan_reduced<P>(num, select(den == 0, X(1), den), offset); // atan2(0, 0) = 0
+
+    // Reflect into the left half-plane where x is negative (including -0), then take the sign of y.
+    const auto x_negative = (reinterpret_as_int(x) >> sign_shift) != 0;
+    return detail::xor_sign(select(x_negative, X(pi) - r, r), y);
+}
+
+static_assert(atan2(0.f, 0.f) == 0.f);
+static_assert(atan2(0.f, -0.f) == std::numbers::pi_v<float>);
+static_assert(atan2(-0.0, -1.0) == -std::numbers::pi);
+static_assert(rel_equal(atan2(1.f, -1.f), 3 * std::numbers::pi_v<float> / 4, 1e-6f));
+static_assert(rel_equal(atan2(-2.0, 1e-3), -std::numbers::pi / 2 + 5e-4, 1e-10));
+
 // MARK: - exp2, log2
 
-///
-template<typename X>
-force_inline constexpr auto exp2(X x) -> X
+namespace detail {
+
+/// Minimax approximations of exp2(x) on -0.5...0.5.
+template<Precision P, typename X>
+force_inline constexpr auto exp2_poly(X x) -> X
+{
+    using S = scalar_t<X>;
+
+    // max relative error 7.5e-5
+    if constexpr (P == Precision::fast) {
+        return poly(x, 0.999928074, 0.693260985, 0.242611122, 0.0551716691);
+    }
+    // max relative error 7.5e-8
+    else if constexpr (P == Precision::balanced && sizeof(S) == 4) {
+        return poly(x, 1.00000007, 0.69314697, 0.2402212, 0.05550713, 0.00967553, 0.00132767);
+    }
+    // max relative error 4.0e-11
+    else if constexpr (P == Precision::balanced) {
+        return poly<Poly_scheme::estrin>(x, 0.99999999996168193, 0.69314718072844706, 0.24022651198157586,
+                                         0.055504103534479795, 0.0096180272536684498, 0.0013333922563538981,
+                                         0.00015469291141688513, 1.5201921594525978e-5);
+    }
+    // max relative error 1.9e-9
+    else if constexpr (P == Precision::full && sizeof(S) == 4) {
+        return poly(x, 1.0000000005541665, 0.69314720573726808, 0.24022646890634086, 0.055503287769647253,
+                    0.0096184889571152174, 0.0013399931219340945, 0.00015345812002868575);
+    }
+    // max relative error 3.1e-18
+    else {
+        return poly(x, 1.0, 0.69314718055994533, 0.24022650695910156, 0.055504108664819921, 0.009618129107588335,
+                    0.0013333558146789953, 0.00015403530462514668, 1.5252733489958517e-5, 1.3215433089567188e-6,
+                    1.0178198034321092e-7, 7.0741056308632988e-9, 4.4352807904353443e-10);
+    }
+}
+
+/// 2^k exp2(f), for integral k within the exponent range and |f| <= 1/2.
+template<Precision P, typename X>
+force_inline constexpr auto exp2_split(X k, X f) -> X
 {
     using S = scalar_t<X>;
     constexpr auto exp_bias = ieee_exp_bias_v<S>;
     constexpr auto sig_bits = ieee_sig_bits_v<S>;
 
-    const auto int_part = float_to_signed(cxm::round(x));
-    const auto dec_part = x - signed_to_float(int_part);
-    
     // In C++20 we have two's complement.
-    const auto val = (signed_to_unsigned(int_part) + exp_bias) << sig_bits;
+    const auto val = (signed_to_unsigned(float_to_signed(k)) + exp_bias) << sig_bits;
     const auto int_pow = reinterpret_as_float(val);
-    
-    // minimax approximation of exp2 on -0.5...0.5
-    // computed with cvxpy
-    constexpr auto c0 = X(1.00000007);
-    constexpr auto c1 = X(0.69314697);
-    constexpr auto c2 = X(0.2402212);
-    constexpr auto c3 = X(0.05550713);
-    constexpr auto c4 = X(0.00967553);
-    constexpr auto c5 = X(0.00132767);
-    
-    const auto dec_pow = c0 + dec_part * (c1 + dec_part * (c2 + dec_part * (c3 + dec_part * (c4 + dec_part * c5))));
 
-    return int_pow * dec_pow;
+    return int_pow * exp2_poly<P>(f);
+}
+
+} // namespace detail
+
+///
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto exp2(X x) -> X
+{
+    const auto k = cxm::round(x);
+    return detail::exp2_split<P>(k, x - k);
 }
 
 static_assert(abs_equal(exp2(-3.f), 1 / 8.f));
@@ -374,8 +1087,54 @@ static_assert(abs_equal(exp2(1.0), 2.0, 1e-6));
 static_assert(abs_equal(exp2(2.0), 4.0, 1e-6));
 static_assert(abs_equal(exp2(3.5), 11.313708, 1e-6));
 
+static_assert(rel_equal(exp2<precision::fast>(3.5f), 11.313708f, 1e-4f));
+static_assert(rel_equal(exp2<precision::full>(3.5f), 11.313708f, 1e-6f));
+static_assert(rel_equal(exp2<precision::balanced>(3.5), 11.313708498984761, 1e-10));
+static_assert(rel_equal(exp2<precision::full>(3.5), 11.313708498984761, 1e-15));
+
+namespace detail {
+
+/// Minimax approximations of log2(m) for m in sqrt(0.5)...sqrt(2).
+template<Precision P, typename X>
+force_inline constexpr auto log2_poly(X m) -> X
+{
+    using S = scalar_t<X>;
+
+    // log2(1 + t) = t * q(t), max relative error 5.0e-5
+    if constexpr (P == Precision::fast) {
+        const auto t = m - 1;
+        return t * poly(t, 1.44264625, -0.720554972, 0.485306515, -0.390892442, 0.254751873);
+    }
+    else {
+        // log2(m) = s * r(s^2) with s = (m - 1) / (m + 1), which is in -0.172...0.172.
+        const auto s = (m - 1) / (m + 1);
+        const auto s2 = s * s;
+
+        // max relative error 1.2e-7
+        if constexpr (P == Precision::balanced && sizeof(S) == 4) {
+            return s * poly(s2, 2.8853904242362612, 0.9615883259636532, 0.59578072339257907);
+        }
+        // max relative error 4.2e-12
+        else if constexpr (P == Precision::balanced) {
+            return s * poly(s2, 2.8853900817900802, 0.96179667335005912, 0.57708358326954252, 0.41167282689210108,
+                            0.34072800828398911);
+        }
+        // max relative error 6.9e-10
+        else if constexpr (P == Precision::full && sizeof(S) == 4) {
+            return s * poly(s2, 2.8853900797889262, 0.96179884764156772, 0.57671438398545536, 0.43173587862815618);
+        }
+        // max relative error 1.1e-18
+        else {
+            return s * poly(s2, 2.8853900817779268, 0.96179669392598982, 0.57707801634547037, 0.41219858585107279,
+                            0.32059853392591971, 0.26233440176173506, 0.22091186666360473, 0.21367077957588438);
+        }
+    }
+}
+
+} // namespace detail
+
 ///
-template<typename X>
+template<Precision P = Precision::balanced, typename X>
 force_inline constexpr auto log2(X x) -> X
 {
     using S = scalar_t<X>;
@@ -387,24 +1146,12 @@ force_inline constexpr auto log2(X x) -> X
     // In C++ 20 we have two's complement.
     const auto bits = reinterpret_as_int(x);
     const auto val = unsigned_to_signed((bits >> sig_bits) - exp_bias);
-    const auto int_part = signed_to_float(val);
     const auto m = reinterpret_as_float((exp_bias << sig_bits) | (bits & sig_mask));
 
-    // Compute quadratic approximation of log2 on 1...2.
-    // see: https://tech.ebayinc.com/engineering/fast-approximate-logarithms-part-i-the-basics/
-    // const auto dec_part = X(-1 / 3.0) * m * m + 2 * m - X(5 / 3.0);
-    
-    // minimax approximation
-    // computed using cvxpy
-    constexpr auto c1 = X(1.44268127);
-    constexpr auto c2 = X(-0.72039364);
-    constexpr auto c3 = X(0.46899335);
-    constexpr auto c4 = X(-0.30262538);
-    constexpr auto c5 = X(0.1456237);
-    constexpr auto c6 = X(-0.03428757);
-
-    const auto xm = m - 1; // polynomial is in x-1
-    const auto dec_part = xm * (c1 + xm * (c2 + xm * (c3 + xm * (c4 + xm * (c5 + xm * c6)))));
+    // Center the mantissa on 1, so log2 keeps its relative accuracy for x near 1.
+    const auto high = m > X(std::numbers::sqrt2_v<S>);
+    const auto int_part = signed_to_float(val) + select(high, X(1), X(0));
+    const auto dec_part = detail::log2_poly<P>(select(high, m * S(0.5), m));
 
     return int_part + dec_part;
 }
@@ -423,51 +1170,218 @@ static_assert(abs_equal(log2(2.0), 1.0));
 static_assert(abs_equal(log2(8.0), 3.0));
 static_assert(abs_equal(log2(69.0), 6.108524, 1e-5));
 
+static_assert(abs_equal(log2<precision::fast>(69.f), 6.108524f, 1e-3f));
+static_assert(rel_equal(log2<precision::full>(0.999f), -0.00144339828f, 1e-6f));
+static_assert(rel_equal(log2<precision::balanced>(69.0), 6.1085244567781691, 1e-11));
+static_assert(rel_equal(log2<precision::full>(69.0), 6.1085244567781691, 1e-15));
+
 // MARK: - exp, log, pow, etc.
 
-///
+namespace detail {
+
+/**
+ * @brief Cody-Waite reduction: x - k * ln(2), for integral k.
+ *
+ * ln(2) is split as for sub_half_pi, so the result is accurate for every k in the exponent range.
+ */
 template<typename X>
-force_inline constexpr auto exp(X x) -> X
+force_inline constexpr auto sub_ln2(X x, X k) -> X
 {
     using S = scalar_t<X>;
-    return cxm::exp2(std::numbers::log2e_v<S> * x);
+
+    if constexpr (sizeof(S) == 4) {
+        // 15 + 24 bits
+        return (x - k * X(0.693145751953125f)) - k * X(1.42860677e-6f);
+    }
+    else {
+        // 32 + 53 bits (fdlibm's split)
+        return (x - k * X(6.93147180369123816490e-01)) - k * X(1.90821492927058770002e-10);
+    }
 }
 
-///
-template<typename X>
+/// exp(x) / 2^J, without rounding x - J ln(2), so it's accurate up to where the result itself overflows. See exp.
+template<Precision P, int J = 0, typename X>
+force_inline constexpr auto exp_scaled(X x) -> X
+{
+    using S = scalar_t<X>;
+    if constexpr (P == Precision::fast) {
+        return cxm::exp2<P>(std::numbers::log2e_v<S> * x - X(J));
+    }
+    else {
+        const auto k = cxm::round(x * X(std::numbers::log2e_v<S>));
+        return exp2_split<P>(k - X(J), sub_ln2(x, k) * X(std::numbers::log2e_v<S>));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief exp(x), as 2^k exp2(f) with k = round(x log2(e)).
+ *
+ * Balanced and full subtract k ln(2) from x exactly (see sub_ln2), so the error doesn't grow with |x|. Fast just
+ * scales x by log2(e), which adds up to |x| epsilon, well within its own error. Relative error: fast 8e-5, balanced
+ * 4 ULP (float) or 4e-11 (double), full 2 ULP. x must be within about -87...88 for float and -708...709 for double.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto exp(X x) -> X
+{
+    return detail::exp_scaled<P>(x);
+}
+
+static_assert(rel_equal(exp<precision::full>(80.f), 5.54062238e34f, 3e-7f));
+static_assert(rel_equal(exp<precision::full>(700.0), 1.0142320547350045e304, 5e-16));
+
+/**
+ * @brief log(x), as ln(2) log2(x).
+ *
+ * Relative error: fast 5e-5, balanced 5 ULP (float) or 5e-12 (double), full 3 ULP.
+ */
+template<Precision P = Precision::balanced, typename X>
 force_inline constexpr auto log(X x) -> X
 {
     using S = scalar_t<X>;
-    return std::numbers::ln2_v<S> * cxm::log2(x);
+    return std::numbers::ln2_v<S> * cxm::log2<P>(x);
 }
 
-///
-template<typename X>
+/// log10(x), as log10(2) log2(x). Errors as for log, but 4 ULP at full.
+template<Precision P = Precision::balanced, typename X>
 force_inline constexpr auto log10(X x) -> X
 {
     using S = scalar_t<X>;
     constexpr auto log10_2 = std::numbers::ln2_v<S> / std::numbers::ln10_v<S>;
-    return log10_2 * cxm::log2(x);
+    return log10_2 * cxm::log2<P>(x);
 }
 
-///
-template<typename X>
+/// The base-b logarithm of x, as log2(x) / log2(b). Errors as for log.
+template<Precision P = Precision::balanced, typename X>
 force_inline constexpr auto logB(X b, X x) -> X
 {
-    return cxm::log2(x) / cxm::log2(b);
+    return cxm::log2<P>(x) / cxm::log2<P>(b);
 }
 
-///
-template<typename X>
+/**
+ * @brief x^y for positive x, as exp2(y log2(x)).
+ *
+ * log2's error is scaled by y, and exp2 turns it into relative error, so the error grows with |y log2(x)|: roughly
+ * that many ULP on top of exp2's. At full, x^1.5 near 1e-20 (y log2(x) = -97) is 110 ULP, for float and double.
+ * Fast is within 1e-4 over the same range.
+ */
+template<Precision P = Precision::balanced, typename X>
 force_inline constexpr auto pow(X x, X y) -> X
 {
-    return cxm::exp2(cxm::log2(x) * y);
+    return cxm::exp2<P>(cxm::log2<P>(x) * y);
 }
 
 static_assert(abs_equal(pow(2.f, 1.5f), 2.828427f, 1e-6f));
 static_assert(rel_equal(pow(10.f, -48 / 20.f), 0.00398f));
 static_assert(rel_equal(pow(10.f, 36 / 20.f), 63.09573f));
 
+// MARK: - Hyperbolic Trig Functions
+
+namespace detail {
+
+/// The Taylor series of sinh(a) / a (Odd) or cosh(a) in z = a^2, truncated to N terms.
+template<bool Odd, size_t N>
+consteval auto hyperbolic_series() -> std::array<double, N>
+{
+    auto c = std::array<double, N>{};
+    auto factorial = 1.0;
+    for (size_t k = 0; k < N; ++k) {
+        c[k] = 1 / factorial;
+        factorial *= (2 * k + 1 + Odd) * (2 * k + 2 + Odd);
+    }
+    return c;
+}
+
+/// Terms of the series for |a| <= 1/2. The relative error of the last one dropped is below 0.25^N / (2 N)!: fast 2e-5,
+/// balanced 1e-7 (float) or 5e-13 (double), full 3e-10 (float) or 1e-18 (double).
+template<Precision P, typename S>
+consteval auto hyperbolic_terms() -> size_t
+{
+    if constexpr (P == Precision::fast) {
+        return 3;
+    }
+    else if constexpr (sizeof(S) == 4) {
+        return P == Precision::balanced ? 4 : 5;
+    }
+    else {
+        return P == Precision::balanced ? 6 : 8;
+    }
+}
+
+template<Precision P, typename X>
+force_inline constexpr auto sinh_poly(X a) -> X
+{
+    constexpr auto n = hyperbolic_terms<P, scalar_t<X>>();
+    return a * poly(a * a, hyperbolic_series<true, n>());
+}
+
+template<Precision P, typename X>
+force_inline constexpr auto cosh_poly(X a) -> X
+{
+    constexpr auto n = hyperbolic_terms<P, scalar_t<X>>();
+    return poly(a * a, hyperbolic_series<false, n>());
+}
+
+} // namespace detail
+
+/**
+ * @brief cosh(x) as h + 1 / (4 h), where h = exp(|x|) / 2.
+ *
+ * Errors as for exp at |x|, and |x| must be within exp's range: below about 88 for float and 709 for double.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto cosh(X x) -> X
+{
+    const auto h = detail::exp_scaled<P, 1>(cxm::abs(x));
+    return h + X(0.25) / h;
+}
+
+static_assert(cosh(0.f) == 1.f);
+static_assert(rel_equal(cosh(-3.f), 10.067662f, 1e-6f));
+static_assert(rel_equal(cosh<precision::full>(0.1), 1.0050041680558035, 1e-15));
+
+/**
+ * @brief sinh(x), from the Taylor series for |x| <= 1/2 and h - 1 / (4 h) above, with h as for cosh.
+ *
+ * h - 1 / (4 h) cancels a little just above 1/2. Relative error: fast 1.3e-4, balanced 5 ULP (float) or 8e-11
+ * (double), full 3 ULP. |x| must be within exp's range, as for cosh.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto sinh(X x) -> X
+{
+    const auto a = cxm::abs(x);
+    const auto h = detail::exp_scaled<P, 1>(a);
+    const auto r = select(a <= X(0.5), detail::sinh_poly<P>(a), h - X(0.25) / h);
+    return detail::xor_sign(r, x);
+}
+
+static_assert(sinh(0.f) == 0.f);
+static_assert(rel_equal(sinh(-3.f), -10.017875f, 1e-6f));
+static_assert(rel_equal(sinh<precision::full>(0.1), 0.10016675001984403, 1e-15));
+
+/**
+ * @brief tanh(x), as sinh / cosh from the Taylor series for |x| <= 1/2 and 1 - 2 / (exp(2 |x|) + 1) above.
+ *
+ * |x| is clamped to 20, where tanh rounds to 1 in double. Relative error: fast 6e-5, balanced 4 ULP (float) or 4e-11
+ * (double), full 3 ULP.
+ */
+template<Precision P = Precision::balanced, typename X>
+force_inline constexpr auto tanh(X x) -> X
+{
+    const auto a = cxm::abs(x);
+    const auto near = a <= X(0.5);
+    const auto e = cxm::exp<P>(X(2) * select(a > X(20), X(20), a));
+    const auto num = select(near, detail::sinh_poly<P>(a), e - X(1));
+    const auto den = select(near, detail::cosh_poly<P>(a), e + X(1));
+    return detail::xor_sign(num / den, x);
+}
+
+static_assert(tanh(0.f) == 0.f);
+static_assert(tanh(100.f) == 1.f);
+static_assert(rel_equal(tanh(-0.3f), -0.29131261f, 1e-6f));
+static_assert(rel_equal(tanh<precision::full>(2.0), 0.96402758007581690, 1e-15));
+
 // MARK: - Other
 
 ///
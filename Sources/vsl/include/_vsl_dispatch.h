@@ -0,0 +1,349 @@
+#ifndef _vsl_dispatch_h
+#define _vsl_dispatch_h
+
+#include <cstdlib> // getenv
+#include <cstring> // strcmp
+#include <span>
+
+#include "_vsl_block.h"
+#include "_vsl_core.h"
+#include "_vsl_cxm.h"
+#include "_vsl_rand.h"
+
+/**
+ * Runtime CPU dispatch.
+ *
+ * Everything else in vsl is compiled for the ISA the translation unit targets. The kernels here are compiled once per
+ * ISA level with function target attributes and picked on first call from what the CPU supports, so one binary runs
+ * AVX-512 code where it's available and falls back on older machines.
+ *
+ * Set the `VSL_ISA` environment variable (`baseline`, `sse4.2`, `avx2`, `avx512` or `neon`) to force a lower level.
+ * Levels the CPU doesn't support are ignored.
+ */
+namespace vsl::dispatch {
+
+// MARK: - Instruction sets
+
+enum class Instruction_set {
+    baseline, sse4_2, avx2, avx512, neon
+};
+
+#if defined(__x86_64__) || defined(__i386__)
+#define _VSL_DISPATCH_X86 1
+#define _VSL_TARGET_SSE4_2 __attribute__((target("sse4.2")))
+#define _VSL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define _VSL_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx2,fma")))
+#else
+#define _VSL_DISPATCH_X86 0
+#endif
+
+/// The name of an instruction set, as accepted by `VSL_ISA`.
+inline constexpr auto name(Instruction_set isa) -> const char*
+{
+    switch (isa) {
+        case Instruction_set::baseline: return "baseline";
+        case Instruction_set::sse4_2: return "sse4.2";
+        case Instruction_set::avx2: return "avx2";
+        case Instruction_set::avx512: return "avx512";
+        case Instruction_set::neon: return "neon";
+    }
+    return "baseline";
+}
+
+/// The widest instruction set this CPU supports. (Queried once.)
+inline auto detected() -> Instruction_set
+{
+    static const auto isa = [] {
+#if _VSL_DISPATCH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+            return Instruction_set::avx512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return Instruction_set::avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return Instruction_set::sse4_2;
+        }
+        return Instruction_set::baseline;
+#elif defined(__ARM_NEON)
+        return Instruction_set::neon;
+#else
+        return Instruction_set::baseline;
+#endif
+    }();
+    return isa;
+}
+
+/// Whether kernels compiled for an instruction set can run on this CPU.
+inline auto supported(Instruction_set isa) -> bool
+{
+    const auto cpu = detected();
+
+    switch (isa) {
+        case Instruction_set::baseline: return true;
+        case Instruction_set::neon: return cpu == Instruction_set::neon;
+        default: return _VSL_DISPATCH_X86 && cpu != Instruction_set::neon && isa <= cpu;
+    }
+}
+
+/// The instruction set dispatched kernels run: the detected one, unless `VSL_ISA` names another supported one.
+inline auto active() -> Instruction_set
+{
+    static const auto isa = [] {
+        if (const auto env = std::getenv("VSL_ISA")) {
+            for (const auto isa : {Instruction_set::baseline, Instruction_set::sse4_2, Instruction_set::avx2,
+                                   Instruction_set::avx512, Instruction_set::neon}) {
+                if (std::strcmp(env, name(isa)) == 0 && supported(isa)) {
+                    return isa;
+                }
+            }
+        }
+        return detected();
+    }();
+    return isa;
+}
+
+// MARK: - Kernel tables
+
+namespace detail {
+
+/// The block vector type kernels use for scalar type S on an instruction set.
+template<typename S, size_t Bytes>
+using isa_vector_t = vector_of_t<S, Bytes / sizeof(S)>;
+
+/**
+ * @brief Compiles a block operation once per instruction set and resolves it on first call.
+ *
+ * Op has a static `run<Bytes>(args...)` that does the work with Bytes-wide registers. Everything it calls must be
+ * force_inline, so the whole kernel is generated for each target. (An out-of-line call would also pass wide vectors
+ * with a different ABI.)
+ */
+template<typename Op, typename... Args>
+struct Kernel {
+
+    using Fn = void (*)(Args...);
+
+    static auto baseline(Args... args) -> void
+    {
+        Op::template run<16>(args...);
+    }
+
+#if _VSL_DISPATCH_X86
+    _VSL_TARGET_SSE4_2 static auto sse4_2(Args... args) -> void
+    {
+        Op::template run<16>(args...);
+    }
+
+    _VSL_TARGET_AVX2 static auto avx2(Args... args) -> void
+    {
+        Op::template run<32>(args...);
+    }
+
+    _VSL_TARGET_AVX512 static auto avx512(Args... args) -> void
+    {
+        Op::template run<64>(args...);
+    }
+#endif
+
+    /// The kernel for an instruction set. (Which must be supported.)
+    static auto select(Instruction_set isa) -> Fn
+    {
+        switch (isa) {
+#if _VSL_DISPATCH_X86
+            case Instruction_set::sse4_2: return sse4_2;
+            case Instruction_set::avx2: return avx2;
+            case Instruction_set::avx512: return avx512;
+#endif
+            default: return baseline; // (NEON is the AArch64 baseline.)
+        }
+    }
+
+    static auto call(Args... args) -> void
+    {
+        static const auto fn = select(active());
+        fn(args...);
+    }
+};
+
+} // namespace detail
+
+// MARK: - Random_gen
+
+namespace detail {
+
+template<typename X, Random_engine Engine>
+struct Fill_op {
+    template<size_t Bytes>
+    force_inline static auto run(Random_gen<X, Engine>& gen, std::span<scalar_t<X>> out) -> void
+    {
+        gen.fill(out);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Random_gen::fill, dispatched.
+ *
+ * The generator's vector type sets the stream, so every instruction set produces the same values (up to FMA
+ * rounding in the final scale). Wide generators like `Random_gen<float16>` benefit most; narrower registers just
+ * take several instructions per value.
+ */
+template<typename X, Random_engine Engine>
+inline auto fill(Random_gen<X, Engine>& gen, std::span<scalar_t<X>> out) -> void
+{
+    detail::Kernel<detail::Fill_op<X, Engine>, Random_gen<X, Engine>&, std::span<scalar_t<X>>>::call(gen, out);
+}
+
+// MARK: - cxm kernels
+
+namespace cxm {
+
+// Same signatures as vsl::block::cxm.
+
+#define _VSL_DISPATCH_UNARY_S(S, name, fn) \
+    inline auto name(std::span<const S> in, std::span<S> out) -> void \
+    { \
+        dispatch::detail::Kernel<detail::name##_op, std::span<const S>, std::span<S>>::call(in, out); \
+    } \
+    inline auto name(std::span<S> x) -> void \
+    { \
+        name(std::span<const S>(x), x); \
+    }
+
+#define _VSL_DISPATCH_BINARY_S(S, name, fn) \
+    inline auto name(std::span<const S> a, std::span<const S> b, std::span<S> out) -> void \
+    { \
+        using K = dispatch::detail::Kernel<detail::name##_op, \
+                                           std::span<const S>, std::span<const S>, std::span<S>>; \
+        K::call(a, b, out); \
+    } \
+    inline auto name(std::span<S> a, std::span<const S> b) -> void \
+    { \
+        name(std::span<const S>(a), b, a); \
+    }
+
+#define _VSL_DISPATCH_RANGE_S(S, name, fn) \
+    inline auto name(std::span<const S> in, std::span<S> out, S lo, S hi) -> void \
+    { \
+        using K = dispatch::detail::Kernel<detail::name##_range_op, std::span<const S>, std::span<S>, S, S>; \
+        K::call(in, out, lo, hi); \
+    } \
+    inline auto name(std::span<S> x, S lo, S hi) -> void \
+    { \
+        name(std::span<const S>(x), x, lo, hi); \
+    }
+
+#define _VSL_DISPATCH_SPLIT_S(S, name, fn) \
+    inline auto name(std::span<const S> in, std::span<S> out_a, std::span<S> out_b) -> void \
+    { \
+        using K = dispatch::detail::Kernel<detail::name##_op, std::span<const S>, std::span<S>, std::span<S>>; \
+        K::call(in, out_a, out_b); \
+    }
+
+#define _VSL_DISPATCH_UNARY(name, fn) \
+    namespace detail { \
+    struct name##_op { \
+        template<size_t Bytes, typename S> \
+        force_inline static auto run(std::span<const S> in, std::span<S> out) -> void \
+        { \
+            block::detail::transform<dispatch::detail::isa_vector_t<S, Bytes>>( \
+                in, out, [](auto v) __attribute__((always_inline)) { return fn(v); }); \
+        } \
+    }; \
+    } \
+    _VSL_DISPATCH_UNARY_S(float, name, fn) _VSL_DISPATCH_UNARY_S(double, name, fn)
+
+#define _VSL_DISPATCH_BINARY(name, fn) \
+    namespace detail { \
+    struct name##_op { \
+        template<size_t Bytes, typename S> \
+        force_inline static auto run(std::span<const S> a, std::span<const S> b, std::span<S> out) -> void \
+        { \
+            block::detail::transform<dispatch::detail::isa_vector_t<S, Bytes>>( \
+                a, b, out, [](auto v, auto w) __attribute__((always_inline)) { return fn(v, w); }); \
+        } \
+    }; \
+    } \
+    _VSL_DISPATCH_BINARY_S(float, name, fn) _VSL_DISPATCH_BINARY_S(double, name, fn)
+
+#define _VSL_DISPATCH_RANGE(name, fn) \
+    namespace detail { \
+    struct name##_range_op { \
+        template<size_t Bytes, typename S> \
+        force_inline static auto run(std::span<const S> in, std::span<S> out, S lo, S hi) -> void \
+        { \
+            block::detail::transform<dispatch::detail::isa_vector_t<S, Bytes>>( \
+                in, out, [lo, hi](auto v) __attribute__((always_inline)) { return fn(v, lo, hi); }); \
+        } \
+    }; \
+    } \
+    _VSL_DISPATCH_RANGE_S(float, name, fn) _VSL_DISPATCH_RANGE_S(double, name, fn)
+
+#define _VSL_DISPATCH_SPLIT(name, fn) \
+    namespace detail { \
+    struct name##_op { \
+        template<size_t Bytes, typename S> \
+        force_inline static auto run(std::span<const S> in, std::span<S> out_a, std::span<S> out_b) -> void \
+        { \
+            block::detail::transform<dispatch::detail::isa_vector_t<S, Bytes>>( \
+                in, out_a, out_b, [](auto v) __attribute__((always_inline)) { return fn(v); }); \
+        } \
+    }; \
+    } \
+    _VSL_DISPATCH_SPLIT_S(float, name, fn) _VSL_DISPATCH_SPLIT_S(double, name, fn)
+
+_VSL_DISPATCH_UNARY(abs, vsl::cxm::abs)
+_VSL_DISPATCH_UNARY(trunc, vsl::cxm::trunc)
+_VSL_DISPATCH_UNARY(floor, vsl::cxm::floor)
+_VSL_DISPATCH_UNARY(ceil, vsl::cxm::ceil)
+_VSL_DISPATCH_UNARY(round, vsl::cxm::round)
+_VSL_DISPATCH_BINARY(fmod, vsl::cxm::fmod)
+_VSL_DISPATCH_UNARY(wrap, vsl::cxm::wrap)
+_VSL_DISPATCH_RANGE(wrap, vsl::cxm::wrap)
+_VSL_DISPATCH_UNARY(cos, vsl::cxm::cos)
+_VSL_DISPATCH_UNARY(sin, vsl::cxm::sin)
+_VSL_DISPATCH_SPLIT(sincos, vsl::cxm::sincos)
+_VSL_DISPATCH_UNARY(cos_phase, vsl::cxm::cos_phase)
+_VSL_DISPATCH_UNARY(sin_phase, vsl::cxm::sin_phase)
+_VSL_DISPATCH_SPLIT(sincos_phase, vsl::cxm::sincos_phase)
+_VSL_DISPATCH_UNARY(tan, vsl::cxm::tan)
+_VSL_DISPATCH_UNARY(asin, vsl::cxm::asin)
+_VSL_DISPATCH_UNARY(acos, vsl::cxm::acos)
+_VSL_DISPATCH_UNARY(atan, vsl::cxm::atan)
+_VSL_DISPATCH_BINARY(atan2, vsl::cxm::atan2) // (y, x, out)
+_VSL_DISPATCH_UNARY(cosh, vsl::cxm::cosh)
+_VSL_DISPATCH_UNARY(sinh, vsl::cxm::sinh)
+_VSL_DISPATCH_UNARY(tanh, vsl::cxm::tanh)
+_VSL_DISPATCH_UNARY(exp2, vsl::cxm::exp2)
+_VSL_DISPATCH_UNARY(log2, vsl::cxm::log2)
+_VSL_DISPATCH_UNARY(exp, vsl::cxm::exp)
+_VSL_DISPATCH_UNARY(log, vsl::cxm::log)
+_VSL_DISPATCH_UNARY(log10, vsl::cxm::log10)
+_VSL_DISPATCH_BINARY(logB, vsl::cxm::logB)
+_VSL_DISPATCH_BINARY(pow, vsl::cxm::pow)
+_VSL_DISPATCH_UNARY(rcp, vsl::cxm::rcp)
+_VSL_DISPATCH_UNARY(rsqrt, vsl::cxm::rsqrt)
+_VSL_DISPATCH_UNARY(sqrt, vsl::cxm::sqrt)
+_VSL_DISPATCH_UNARY(cbrt, vsl::cxm::cbrt)
+_VSL_DISPATCH_BINARY(hypot, vsl::cxm::hypot)
+_VSL_DISPATCH_BINARY(min, vsl::cxm::min)
+_VSL_DISPATCH_BINARY(max, vsl::cxm::max)
+_VSL_DISPATCH_RANGE(clamp, vsl::cxm::clamp)
+_VSL_DISPATCH_UNARY(sign, vsl::cxm::sign)
+
+#undef _VSL_DISPATCH_UNARY
+#undef _VSL_DISPATCH_BINARY
+#undef _VSL_DISPATCH_RANGE
+#undef _VSL_DISPATCH_SPLIT
+#undef _VSL_DISPATCH_UNARY_S
+#undef _VSL_DISPATCH_BINARY_S
+#undef _VSL_DISPATCH_RANGE_S
+#undef _VSL_DISPATCH_SPLIT_S
+
+} // namespace cxm
+
+} // namespace vsl::dispatch
+
+#endif /* _vsl_dispatch_h */
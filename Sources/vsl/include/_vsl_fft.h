@@ -0,0 +1,563 @@
+#ifndef _vsl_fft_h
+#define _vsl_fft_h
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring> // memcpy
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "_vsl_block.h"   // loads, stores, deinterleave
+#include "_vsl_complex.h"
+#include "_vsl_core.h"
+#include "_vsl_memory.h"
+
+namespace vsl {
+
+// MARK: - Passes
+
+namespace detail {
+
+/// Element i of a buffer of E, where E is a scalar or a vector and p points at its scalars.
+template<typename E>
+force_inline auto fft_load(const scalar_t<E>* real, const scalar_t<E>* imag, size_t i) -> Complex<E>
+{
+    if constexpr (is_vector_v<E>) {
+        constexpr auto width = num_members_v<E>;
+        return {block::detail::load<E>(real + i * width), block::detail::load<E>(imag + i * width)};
+    }
+    else {
+        return {real[i], imag[i]};
+    }
+}
+
+template<typename E>
+force_inline auto fft_store(scalar_t<E>* real, scalar_t<E>* imag, size_t i, const Complex<E>& z) -> void
+{
+    if constexpr (is_vector_v<E>) {
+        constexpr auto width = num_members_v<E>;
+        block::detail::store(real + i * width, z.real);
+        block::detail::store(imag + i * width, z.imag);
+    }
+    else {
+        real[i] = z.real;
+        imag[i] = z.imag;
+    }
+}
+
+/// The radix-4 butterfly: a forward DFT of (a, b, c, d), with the last three outputs twiddled.
+template<typename E>
+force_inline auto fft_butterfly4(Complex<E> a, Complex<E> b, Complex<E> c, Complex<E> d, const Complex<E>& w1,
+                                 const Complex<E>& w2, const Complex<E>& w3) -> std::array<Complex<E>, 4>
+{
+    const auto apc = a + c;
+    const auto amc = a - c;
+    const auto bpd = b + d;
+    const auto bmd = b - d;
+    const auto jbmd = Complex<E>{-bmd.imag, bmd.real};
+
+    return {apc + bpd, w1 * (amc - jbmd), w2 * (apc - bpd), w3 * (amc + jbmd)};
+}
+
+/**
+ * @brief One radix-4 Stockham pass, x to y, over elements of E.
+ *
+ * The current sub-transforms have 4m points, s apart. Output r of butterfly p goes to 4p + r, so after the last pass
+ * the result is in natural order without a bit-reversal.
+ *
+ * @param w The pass's twiddles: real and imaginary parts of w^p, w^2p and w^3p, m each.
+ */
+template<typename E>
+inline auto fft_radix4_pass(const scalar_t<E>* xr, const scalar_t<E>* xi, scalar_t<E>* yr, scalar_t<E>* yi,
+                            size_t m, size_t s, const scalar_t<E>* w) -> void
+{
+    using C = Complex<E>;
+
+    for (size_t p = 0; p < m; ++p) {
+        const auto w1 = C{E(w[p]), E(w[m + p])};
+        const auto w2 = C{E(w[2 * m + p]), E(w[3 * m + p])};
+        const auto w3 = C{E(w[4 * m + p]), E(w[5 * m + p])};
+
+        for (size_t q = 0; q < s; ++q) {
+            const auto a = fft_load<E>(xr, xi, q + s * p);
+            const auto b = fft_load<E>(xr, xi, q + s * (p + m));
+            const auto c = fft_load<E>(xr, xi, q + s * (p + 2 * m));
+            const auto d = fft_load<E>(xr, xi, q + s * (p + 3 * m));
+
+            const auto y = fft_butterfly4(a, b, c, d, w1, w2, w3);
+            for (size_t r = 0; r < 4; ++r) {
+                fft_store<E>(yr, yi, q + s * (4 * p + r), y[r]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief The first radix-4 pass of a single transform (s = 1), four butterflies at a time.
+ *
+ * With s = 1 there's nothing to vectorize across q, so this runs butterflies p...p+3 in the lanes of V and
+ * transposes their outputs, which belong at 4p...4p+15. m must be a multiple of 4.
+ */
+template<typename S>
+inline auto fft_radix4_first_pass(const S* xr, const S* xi, S* yr, S* yi, size_t m, const S* w) -> void
+{
+    using V = vector_of_t<S, 4>;
+    using C = Complex<V>;
+    using block::detail::load;
+    using block::detail::store;
+
+    for (size_t p = 0; p < m; p += 4) {
+        const auto a = C{load<V>(xr + p), load<V>(xi + p)};
+        const auto b = C{load<V>(xr + p + m), load<V>(xi + p + m)};
+        const auto c = C{load<V>(xr + p + 2 * m), load<V>(xi + p + 2 * m)};
+        const auto d = C{load<V>(xr + p + 3 * m), load<V>(xi + p + 3 * m)};
+        const auto w1 = C{load<V>(w + p), load<V>(w + m + p)};
+        const auto w2 = C{load<V>(w + 2 * m + p), load<V>(w + 3 * m + p)};
+        const auto w3 = C{load<V>(w + 4 * m + p), load<V>(w + 5 * m + p)};
+
+        auto [y0, y1, y2, y3] = fft_butterfly4(a, b, c, d, w1, w2, w3);
+        transpose(y0.real, y1.real, y2.real, y3.real);
+        transpose(y0.imag, y1.imag, y2.imag, y3.imag);
+
+        store(yr + 4 * p, y0.real);
+        store(yr + 4 * p + 4, y1.real);
+        store(yr + 4 * p + 8, y2.real);
+        store(yr + 4 * p + 12, y3.real);
+        store(yi + 4 * p, y0.imag);
+        store(yi + 4 * p + 4, y1.imag);
+        store(yi + 4 * p + 8, y2.imag);
+        store(yi + 4 * p + 12, y3.imag);
+    }
+}
+
+/// The last pass when the size isn't a power of 4: radix-2 butterflies s apart, with no twiddles.
+template<typename E>
+inline auto fft_radix2_pass(const scalar_t<E>* xr, const scalar_t<E>* xi, scalar_t<E>* yr, scalar_t<E>* yi,
+                            size_t s) -> void
+{
+    for (size_t q = 0; q < s; ++q) {
+        const auto a = fft_load<E>(xr, xi, q);
+        const auto b = fft_load<E>(xr, xi, q + s);
+        fft_store<E>(yr, yi, q, a + b);
+        fft_store<E>(yr, yi, q + s, a - b);
+    }
+}
+
+/// exp(-2 pi i k / n), computed in double.
+inline auto fft_twiddle(size_t k, size_t n) -> Complex<double>
+{
+    const auto angle = -2 * std::numbers::pi * double(k) / double(n);
+    return {std::cos(angle), std::sin(angle)};
+}
+
+} // namespace detail
+
+// MARK: - Complex FFT
+
+/**
+ * @brief A plan for complex FFTs of one power-of-two size.
+ *
+ * The transform is a Stockham autosort FFT: radix-4 passes (plus one radix-2 pass for odd powers of two) that
+ * ping-pong between the output and a scratch buffer, so no bit-reversal is needed and every pass reads and writes
+ * contiguously. Twiddles and scratch are allocated once, by the constructor; forward() and inverse() don't allocate.
+ *
+ * X is the element type:
+ * - A scalar (float, double) transforms one signal. The passes run four butterflies at a time in float4 / double4.
+ * - A vector (e.g. float4) is the batched mode: each member is a separate channel, and all channels are transformed
+ *   together. Buffers hold one X per point, i.e. the channels interleaved.
+ *
+ * A plan has its own scratch, so one plan shouldn't run on two threads at once.
+ *
+ * @tparam X float, double, or a vector of either.
+ */
+template<typename X>
+class Fft {
+public:
+
+    using S = scalar_t<X>;
+
+    /// A plan for n-point transforms. n must be a power of two.
+    explicit Fft(size_t n) : _n{n}, _scratch(2 * n)
+    {
+        assert(std::has_single_bit(n));
+
+        // Passes of 4m points at stride s, from s = 1 up.
+        auto s = size_t{1};
+        for (auto points = n; points >= 4; points /= 4) {
+            const auto m = points / 4;
+            _passes.push_back({m, s, _twiddles.size()});
+            for (size_t k = 1; k <= 3; ++k) {
+                const auto offset = _twiddles.size();
+                _twiddles.resize(offset + 2 * m);
+                for (size_t p = 0; p < m; ++p) {
+                    const auto w = detail::fft_twiddle(k * p, points);
+                    _twiddles[offset + p] = S(w.real);
+                    _twiddles[offset + m + p] = S(w.imag);
+                }
+            }
+            s *= 4;
+        }
+        if (s < n) {
+            _passes.push_back({0, s, 0}); // radix-2
+        }
+    }
+
+    /// The number of points.
+    auto size() const -> size_t { return _n; }
+
+    /// out = DFT(in), unnormalized. in and out may be the same buffer.
+    auto forward(Split_complex<const X> in, Split_complex<X> out) -> void
+    {
+        _run(in, out);
+    }
+
+    /// out = DFT^-1(in), scaled by 1/n so that inverse(forward(x)) is x. in and out may be the same buffer.
+    auto inverse(Split_complex<const X> in, Split_complex<X> out) -> void
+    {
+        // Swapping the parts conjugates and multiplies by i, which turns a forward transform into an inverse.
+        _run({in.imag, in.real}, {out.imag, out.real});
+
+        const auto scale = X(S(1) / S(_n));
+        for (size_t i = 0; i < _n; ++i) {
+            out.real[i] *= scale;
+            out.imag[i] *= scale;
+        }
+    }
+
+private:
+
+    struct Pass {
+        size_t m;               ///< Butterflies per sub-transform. (0 for the radix-2 pass.)
+        size_t s;               ///< Stride, in points.
+        size_t twiddle_offset;
+    };
+
+    auto _run(Split_complex<const X> in, Split_complex<X> out) -> void
+    {
+        assert(in.size() >= _n && in.imag.size() >= _n && out.size() >= _n && out.imag.size() >= _n);
+
+        constexpr auto width = is_vector_v<X> ? num_members_v<X> : 1;
+
+        const auto out_r = reinterpret_cast<S*>(out.real.data());
+        const auto out_i = reinterpret_cast<S*>(out.imag.data());
+        const auto scratch_r = reinterpret_cast<S*>(_scratch.data());
+        const auto scratch_i = scratch_r + _n * width;
+
+        auto src_r = reinterpret_cast<const S*>(in.real.data());
+        auto src_i = reinterpret_cast<const S*>(in.imag.data());
+
+        if (_passes.empty()) {
+            std::memmove(out_r, src_r, _n * sizeof(X));
+            std::memmove(out_i, src_i, _n * sizeof(X));
+            return;
+        }
+
+        // Pick the first destination so the last pass lands in out. The first pass can't write over its own input,
+        // so an in-place call with an odd number of passes starts from a copy.
+        const auto odd = _passes.size() % 2 == 1;
+        if (odd && (src_r == out_r || src_i == out_i || src_r == out_i || src_i == out_r)) {
+            std::memcpy(scratch_r, src_r, _n * sizeof(X));
+            std::memcpy(scratch_i, src_i, _n * sizeof(X));
+            src_r = scratch_r;
+            src_i = scratch_i;
+        }
+        auto to_out = odd;
+
+        for (const auto& pass : _passes) {
+            const auto dst_r = to_out ? out_r : scratch_r;
+            const auto dst_i = to_out ? out_i : scratch_i;
+            _pass(pass, src_r, src_i, dst_r, dst_i);
+            src_r = dst_r;
+            src_i = dst_i;
+            to_out = !to_out;
+        }
+    }
+
+    auto _pass(const Pass& pass, const S* xr, const S* xi, S* yr, S* yi) const -> void
+    {
+        const auto w = _twiddles.data() + pass.twiddle_offset;
+
+        if constexpr (is_vector_v<X>) {
+            // Batched: the channels fill the lanes.
+            if (pass.m == 0) {
+                detail::fft_radix2_pass<X>(xr, xi, yr, yi, pass.s);
+            }
+            else {
+                detail::fft_radix4_pass<X>(xr, xi, yr, yi, pass.m, pass.s, w);
+            }
+        }
+        else {
+            // One signal: four neighbouring strides at a time once s >= 4, four butterflies at a time before that.
+            using V = vector_of_t<S, 4>;
+            if (pass.m == 0) {
+                if (pass.s % 4 == 0) {
+                    detail::fft_radix2_pass<V>(xr, xi, yr, yi, pass.s / 4);
+                }
+                else {
+                    detail::fft_radix2_pass<S>(xr, xi, yr, yi, pass.s);
+                }
+            }
+            else if (pass.s % 4 == 0) {
+                detail::fft_radix4_pass<V>(xr, xi, yr, yi, pass.m, pass.s / 4, w);
+            }
+            else if (pass.m % 4 == 0) {
+                detail::fft_radix4_first_pass<S>(xr, xi, yr, yi, pass.m, w);
+            }
+            else {
+                detail::fft_radix4_pass<S>(xr, xi, yr, yi, pass.m, pass.s, w);
+            }
+        }
+    }
+
+    size_t _n;
+    std::vector<Pass> _passes;
+    std::vector<S> _twiddles;
+    Aligned_buffer<X> _scratch;
+};
+
+// MARK: - Real FFT
+
+/**
+ * @brief A plan for FFTs of real signals of one power-of-two size n.
+ *
+ * The signal is packed into n/2 complex points (even samples real, odd samples imaginary), transformed with an
+ * Fft of size n/2 and then split into the n/2 + 1 non-negative frequency bins. The other half of the spectrum is
+ * their conjugate. Bins 0 and n/2 are real; their imaginary parts are written as 0.
+ *
+ * Like Fft, X may be a vector for the batched mode, and only the constructor allocates.
+ *
+ * @tparam X float, double, or a vector of either.
+ */
+template<typename X>
+class Real_fft {
+public:
+
+    using S = scalar_t<X>;
+
+    /// A plan for n-point transforms. n must be a power of two, at least 2.
+    explicit Real_fft(size_t n) : _n{n}, _fft{n / 2}, _twiddle_r(n / 4 + 1), _twiddle_i(n / 4 + 1), _scratch(n)
+    {
+        assert(n >= 2 && std::has_single_bit(n));
+
+        for (size_t k = 0; k < _twiddle_r.size(); ++k) {
+            const auto w = detail::fft_twiddle(k, n);
+            _twiddle_r[k] = S(w.real);
+            _twiddle_i[k] = S(w.imag);
+        }
+    }
+
+    /// The number of real samples.
+    auto size() const -> size_t { return _n; }
+
+    /// The number of bins forward() writes, n/2 + 1.
+    auto bins() const -> size_t { return _n / 2 + 1; }
+
+    /// out = DFT(in) for bins 0...n/2, unnormalized. out holds bins() numbers.
+    auto forward(std::span<const X> in, Split_complex<X> out) -> void
+    {
+        const auto half = _n / 2;
+        assert(in.size() >= _n && out.size() >= half + 1 && out.imag.size() >= half + 1);
+
+        // Pack: z[k] = in[2k] + i in[2k + 1].
+        const auto z = Split_complex<X>{out.real.first(half), out.imag.first(half)};
+        _deinterleave(in.first(_n), z);
+        _fft.forward(z, z);
+
+        const auto z0 = z[0];
+        out.real[0] = z0.real + z0.imag;
+        out.imag[0] = 0;
+        out.real[half] = z0.real - z0.imag;
+        out.imag[half] = 0;
+
+        _for_each_bin_pair([&]<typename E>(size_t k) __attribute__((always_inline)) {
+            _split<E>(out.real.data(), out.imag.data(), k);
+        });
+    }
+
+    /// out = DFT^-1(in), from bins 0...n/2, scaled by 1/n so that inverse(forward(x)) is x.
+    auto inverse(Split_complex<const X> in, std::span<X> out) -> void
+    {
+        const auto half = _n / 2;
+        assert(in.size() >= half + 1 && in.imag.size() >= half + 1 && out.size() >= _n);
+
+        const auto z = Split_complex<X>{std::span(_scratch).first(half), std::span(_scratch).subspan(half, half)};
+        const auto first = in[0];
+        const auto last = in[half];
+        z.real[0] = (first.real + last.real) * X(0.5);
+        z.imag[0] = (first.real - last.real) * X(0.5);
+
+        _for_each_bin_pair([&]<typename E>(size_t k) __attribute__((always_inline)) {
+            _unsplit<E>(in.real.data(), in.imag.data(), z.real.data(), z.imag.data(), k);
+        });
+
+        _fft.inverse(z, z);
+        _interleave(z, out.first(_n));
+    }
+
+private:
+
+    /**
+     * @brief Calls f.template operator()<E>(k) for bins k = 1...n/4, each paired with its mirror n/2 - k.
+     *
+     * For a single signal, E is a vector of 4 while the bins and their mirrors don't overlap, so lane i holds bin
+     * k + i and mirror n/2 - k - i. The rest, and the batched mode, go one bin at a time with E = X.
+     */
+    template<typename F>
+    force_inline auto _for_each_bin_pair(F f) const -> void
+    {
+        const auto half = _n / 2;
+        auto k = size_t{1};
+
+        if constexpr (!is_vector_v<X>) {
+            for (; k + 6 < half - k; k += 4) {
+                f.template operator()<vector_of_t<S, 4>>(k);
+            }
+        }
+        for (; k <= half / 2; ++k) {
+            f.template operator()<X>(k);
+        }
+    }
+
+    /// Bins k, k + 1, ... as E.
+    template<typename E>
+    static force_inline auto _load_up(const X* p, size_t k) -> E
+    {
+        if constexpr (std::is_same_v<E, X>) {
+            return p[k];
+        }
+        else {
+            return block::detail::load<E>(p + k);
+        }
+    }
+
+    /// Bins j, j - 1, ... as E.
+    template<typename E>
+    static force_inline auto _load_down(const X* p, size_t j) -> E
+    {
+        if constexpr (std::is_same_v<E, X>) {
+            return p[j];
+        }
+        else {
+            const auto v = block::detail::native(block::detail::load<E>(p + j - 3));
+            return E(__builtin_shufflevector(v, v, 3, 2, 1, 0));
+        }
+    }
+
+    template<typename E>
+    static force_inline auto _store_up(X* p, size_t k, E e) -> void
+    {
+        if constexpr (std::is_same_v<E, X>) {
+            p[k] = e;
+        }
+        else {
+            block::detail::store(p + k, e);
+        }
+    }
+
+    template<typename E>
+    static force_inline auto _store_down(X* p, size_t j, E e) -> void
+    {
+        if constexpr (std::is_same_v<E, X>) {
+            p[j] = e;
+        }
+        else {
+            const auto v = block::detail::native(e);
+            block::detail::store(p + j - 3, E(__builtin_shufflevector(v, v, 3, 2, 1, 0)));
+        }
+    }
+
+    /// w^k, w^(k + 1), ... as E.
+    template<typename E>
+    force_inline auto _twiddle(size_t k) const -> Complex<E>
+    {
+        if constexpr (is_vector_v<E> && !is_vector_v<X>) {
+            return {block::detail::load<E>(_twiddle_r.data() + k), block::detail::load<E>(_twiddle_i.data() + k)};
+        }
+        else {
+            return {E(_twiddle_r[k]), E(_twiddle_i[k])};
+        }
+    }
+
+    /**
+     * @brief Turns Z[k] and Z[n/2 - k], the packed transform, into bins k and n/2 - k, in place.
+     *
+     * X[k] = E[k] + w^k O[k], where E and O are the transforms of the even and odd samples:
+     * E[k] = (Z[k] + conj(Z[j])) / 2 and O[k] = -i (Z[k] - conj(Z[j])) / 2, with j = n/2 - k. X[j] is
+     * conj(E[k] - w^k O[k]).
+     */
+    template<typename E>
+    force_inline auto _split(X* real, X* imag, size_t k) const -> void
+    {
+        const auto j = _n / 2 - k;
+        const auto zk = Complex<E>{_load_up<E>(real, k), _load_up<E>(imag, k)};
+        const auto zj = Complex<E>{_load_down<E>(real, j), -_load_down<E>(imag, j)}; // conjugated
+
+        const auto even = (zk + zj) * E(0.5);
+        const auto diff = (zk - zj) * E(0.5);
+        const auto w_odd = _twiddle<E>(k) * Complex<E>{diff.imag, -diff.real};
+
+        _store_up(real, k, even.real + w_odd.real);
+        _store_up(imag, k, even.imag + w_odd.imag);
+        _store_down(real, j, even.real - w_odd.real);
+        _store_down(imag, j, w_odd.imag - even.imag);
+    }
+
+    /// The inverse of _split: E[k] = (X[k] + conj(X[j])) / 2, O[k] = conj(w^k) (X[k] - conj(X[j])) / 2, and
+    /// Z[k] = E[k] + i O[k], Z[j] = conj(E[k]) + i conj(O[k]).
+    template<typename E>
+    force_inline auto _unsplit(const X* in_real, const X* in_imag, X* real, X* imag, size_t k) const -> void
+    {
+        const auto j = _n / 2 - k;
+        const auto xk = Complex<E>{_load_up<E>(in_real, k), _load_up<E>(in_imag, k)};
+        const auto xj = Complex<E>{_load_down<E>(in_real, j), -_load_down<E>(in_imag, j)}; // conjugated
+
+        const auto even = (xk + xj) * E(0.5);
+        const auto odd = vsl::conj(_twiddle<E>(k)) * ((xk - xj) * E(0.5));
+
+        _store_up(real, k, even.real - odd.imag);
+        _store_up(imag, k, even.imag + odd.real);
+        _store_down(real, j, even.real + odd.imag);
+        _store_down(imag, j, odd.real - even.imag);
+    }
+
+    static auto _deinterleave(std::span<const X> in, Split_complex<X> out) -> void
+    {
+        if constexpr (is_vector_v<X>) {
+            for (size_t k = 0; k < out.size(); ++k) {
+                out.real[k] = in[2 * k];
+                out.imag[k] = in[2 * k + 1];
+            }
+        }
+        else {
+            const auto packed = std::span(reinterpret_cast<const Complex<S>*>(in.data()), in.size() / 2);
+            block::deinterleave(packed, out);
+        }
+    }
+
+    static auto _interleave(Split_complex<const X> in, std::span<X> out) -> void
+    {
+        if constexpr (is_vector_v<X>) {
+            for (size_t k = 0; k < in.size(); ++k) {
+                out[2 * k] = in.real[k];
+                out[2 * k + 1] = in.imag[k];
+            }
+        }
+        else {
+            const auto packed = std::span(reinterpret_cast<Complex<S>*>(out.data()), out.size() / 2);
+            block::interleave(in, packed);
+        }
+    }
+
+    size_t _n;
+    Fft<X> _fft;
+    std::vector<S> _twiddle_r;
+    std::vector<S> _twiddle_i;
+    Aligned_buffer<X> _scratch;
+};
+
+} // namespace vsl
+
+#endif /* _vsl_fft_h */
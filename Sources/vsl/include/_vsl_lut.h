@@ -0,0 +1,201 @@
+#ifndef _vsl_lut_h
+#define _vsl_lut_h
+
+#include <array>
+#include <numbers>
+#include <utility> // index_sequence
+
+#include "_vsl_core.h"
+#include "_vsl_cxm.h"   // cos for Chebyshev nodes, min/clamp
+#include "_vsl_utils.h" // float_to_signed, signed_to_float
+
+namespace vsl {
+
+/**
+ * @brief How a Lut evaluates between its breakpoints.
+ *
+ * - linear: straight lines between samples. 2 coefficients per segment.
+ * - hermite: cubic Hermite (Catmull-Rom) through the samples, with tangents from central differences, so the curve
+ *   is C1. 4 coefficients per segment.
+ * - chebyshev: a cubic per segment interpolating the function at 4 Chebyshev nodes. Not continuous at
+ *   the breakpoints, but close to the best cubic on each segment. 4 coefficients per segment.
+ */
+enum class Interpolation {
+    linear, hermite, chebyshev
+};
+
+/**
+ * @brief A function sampled into a table of N segments over [lo, hi], evaluated by interpolation.
+ *
+ * Each segment stores its own polynomial in the local coordinate t = 0...1, so a lookup is a multiply-add to find
+ * the segment, a gather of its coefficients and a short Horner step. Inputs outside [lo, hi] are clamped.
+ *
+ * Make one with lut() into a constexpr variable, so the table is built at compile time and lives in .rodata:
+ *
+ *     static constexpr auto sin_table = vsl::lut<256, vsl::Interpolation::hermite>(
+ *         [](double x) { return vsl::cxm::sin<vsl::precision::full>(x); }, -pi, pi);
+ *
+ * Whether a table beats the cxm polynomial depends on it staying in cache. See the lut rows of vsl-bench.
+ *
+ * @tparam S The stored scalar type.
+ * @tparam N The number of segments.
+ * @tparam I The interpolation.
+ */
+template<typename S, size_t N, Interpolation I>
+struct Lut {
+
+    static_assert(is_scalar_floating_point_v<S>);
+    static_assert(N > 0);
+
+    /// The number of polynomial coefficients stored per segment.
+    static constexpr size_t order = I == Interpolation::linear ? 2 : 4;
+
+    using Segment = std::array<S, order>;
+
+    /// Samples f (called with double) over [lo, hi].
+    template<typename F>
+    constexpr Lut(F f, S lo, S hi) : _lo{lo}, _hi{hi}, _scale{S(N / (double(hi) - double(lo)))}
+    {
+        const auto x0 = double(lo);
+        const auto h = (double(hi) - double(lo)) / N;
+
+        if constexpr (I == Interpolation::linear) {
+            auto y0 = double(f(x0));
+            for (size_t i = 0; i < N; ++i) {
+                const auto y1 = double(f(x0 + h * (i + 1)));
+                _segments[i] = {S(y0), S(y1 - y0)};
+                y0 = y1;
+            }
+        }
+        else if constexpr (I == Interpolation::hermite) {
+            auto y = std::array<double, N + 1>{};
+            for (size_t i = 0; i <= N; ++i) {
+                y[i] = double(f(x0 + h * i));
+            }
+
+            // Tangents in units of t, one-sided at the ends.
+            const auto tangent = [&y](size_t i) {
+                if (i == 0) { return y[1] - y[0]; }
+                if (i == N) { return y[N] - y[N - 1]; }
+                return (y[i + 1] - y[i - 1]) / 2;
+            };
+
+            for (size_t i = 0; i < N; ++i) {
+                const auto m0 = tangent(i);
+                const auto m1 = tangent(i + 1);
+                const auto dy = y[i + 1] - y[i];
+                _segments[i] = {S(y[i]), S(m0), S(3 * dy - 2 * m0 - m1), S(m0 + m1 - 2 * dy)};
+            }
+        }
+        else {
+            // Chebyshev nodes u_k = cos(pi (k + 1/2) / 4) on -1...1.
+            auto u = std::array<double, 4>{};
+            for (size_t k = 0; k < 4; ++k) {
+                u[k] = cxm::cos<Precision::full>(std::numbers::pi * (k + 0.5) / 4);
+            }
+
+            for (size_t i = 0; i < N; ++i) {
+                // Chebyshev coefficients c_j = 2/4 sum_k f(u_k) T_j(u_k), with c_0 halved.
+                auto c = std::array<double, 4>{};
+                for (size_t k = 0; k < 4; ++k) {
+                    const auto y = double(f(x0 + h * (i + (u[k] + 1) / 2)));
+                    const auto u2 = u[k] * u[k];
+                    const auto t = std::array<double, 4>{1, u[k], 2 * u2 - 1, (4 * u2 - 3) * u[k]};
+                    for (size_t j = 0; j < 4; ++j) {
+                        c[j] += y * t[j] / 2;
+                    }
+                }
+                c[0] /= 2;
+
+                // To monomials in u, then substitute u = 2t - 1.
+                const auto a0 = c[0] - c[2];
+                const auto a1 = c[1] - 3 * c[3];
+                const auto a2 = 2 * c[2];
+                const auto a3 = 4 * c[3];
+                _segments[i] = {S(a0 - a1 + a2 - a3), S(2 * a1 - 4 * a2 + 6 * a3), S(4 * a2 - 12 * a3), S(8 * a3)};
+            }
+        }
+    }
+
+    /// The interpolated value at x, clamped to [lo, hi]. X is S or a vector of S.
+    template<typename X>
+    force_inline constexpr auto operator()(X x) const -> X
+    {
+        static_assert(std::is_same_v<scalar_t<X>, S>);
+
+        const auto t = cxm::clamp((x - _lo) * _scale, S(0), S(N));
+        const auto i = cxm::min(float_to_signed(t), signed_counterpart_t<S>(N - 1));
+        const auto frac = t - signed_to_float(i);
+
+        const auto c = gather<X>(i);
+        if constexpr (I == Interpolation::linear) {
+            return c[0] + frac * c[1];
+        }
+        else {
+            return c[0] + frac * (c[1] + frac * (c[2] + frac * c[3]));
+        }
+    }
+
+    constexpr auto lo() const -> S { return _lo; }
+    constexpr auto hi() const -> S { return _hi; }
+    constexpr auto segments() const -> const std::array<Segment, N>& { return _segments; }
+
+private:
+
+    /// The coefficients of the segments at i, transposed into one X per coefficient.
+    ///
+    /// Each member's segment is read whole (a cubic float segment is one 16-byte load), rather than one
+    /// coefficient at a time.
+    template<typename X, typename Index>
+    force_inline constexpr auto gather(Index i) const -> std::array<X, order>
+    {
+        if constexpr (is_vector_v<X>) {
+            return [&]<size_t... J>(std::index_sequence<J...>) __attribute__((always_inline)) {
+                const auto rows = std::array<Segment, sizeof...(J)>{_segments[size_t(i[J])]...};
+
+                const auto column = [&](size_t k) __attribute__((always_inline)) { return X{rows[J][k]...}; };
+
+                return [&]<size_t... K>(std::index_sequence<K...>) __attribute__((always_inline)) {
+                    return std::array<X, order>{column(K)...};
+                }(std::make_index_sequence<order>{});
+            }(std::make_index_sequence<num_members_v<X>>{});
+        }
+        else {
+            return _segments[size_t(i)];
+        }
+    }
+
+    S _lo;
+    S _hi;
+    S _scale;
+    std::array<Segment, N> _segments{};
+};
+
+/**
+ * @brief A Lut of f over [lo, hi]. Assign the result to a constexpr variable to build the table at compile time.
+ *
+ * @tparam N The number of segments.
+ * @tparam I The interpolation.
+ * @tparam S The stored scalar type.
+ */
+template<size_t N, Interpolation I = Interpolation::linear, typename S = float, typename F>
+constexpr auto lut(F f, S lo, S hi) -> Lut<S, N, I>
+{
+    return Lut<S, N, I>(f, lo, hi);
+}
+
+namespace detail {
+
+inline constexpr auto lut_test_f = [](double x) { return x * x * x - x; };
+
+} // namespace detail
+
+static_assert(lut<4>(detail::lut_test_f, 0.f, 2.f)(1.f) == 0.f);
+static_assert(lut<4>(detail::lut_test_f, 0.f, 2.f)(0.25f) == -0.1875f);
+static_assert(lut<4>(detail::lut_test_f, 0.f, 2.f)(5.f) == 6.f);
+static_assert(abs_equal(lut<4, Interpolation::chebyshev>(detail::lut_test_f, 0.f, 2.f)(0.3f), -0.273f, 1e-6f));
+static_assert(abs_equal(lut<4, Interpolation::hermite>(detail::lut_test_f, -1.0, 3.0)(1.5), 1.875, 0.07));
+
+} // namespace vsl
+
+#endif /* _vsl_lut_h */
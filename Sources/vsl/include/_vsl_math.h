@@ -3,18 +3,53 @@
 
 #include <algorithm> // min, max, clamp
 #include <cmath>
+#include <type_traits> // is_constant_evaluated
 
-#include <simd/simd.h>
+#include "_vsl_simd.h"
 
 #include "_vsl_core.h"
-#include "_vsl_cxm.h" // sign, wrap
+#include "_vsl_cxm.h" // constant evaluation and Evaluation::approximate
 
 namespace vsl {
 
-template<typename X>
-force_inline auto abs(X x) -> X
+/**
+ * @brief How the vsl:: math functions evaluate outside constant evaluation.
+ *
+ * During constant evaluation, every function with a cxm:: counterpart runs it, at Precision P (full by default for
+ * exact, so a table computed at compile time is as close to simd:: and std:: as cxm gets). At run time, exact calls
+ * simd:: or std:: and approximate calls cxm:: at P. The two agree to within a few ULP: constant evaluation never fuses
+ * a multiply and an add, while at run time the compiler fuses them where the target has FMA (or AVX-512), so the values
+ * are bit-identical only on targets without FMA or with -ffp-contract=off.
+ * acosh, asinh, atanh and erf have no cxm:: counterpart, so they can't be constant evaluated. round is the exception
+ * the other way: it rounds half away from zero everywhere, with trunc and sign in place of cxm::round.
+ */
+enum class Evaluation {
+    exact,      ///< simd:: or std::. (The default.)
+    approximate ///< cxm::, at Precision::balanced unless the call picks another tier.
+};
+
+/// The Precision of the cxm:: functions behind each Evaluation.
+template<Evaluation E>
+inline constexpr auto default_precision_v = E == Evaluation::exact ? Precision::full : Precision::balanced;
+
+namespace detail {
+
+/// Whether a vsl:: math function with Evaluation E runs its cxm:: counterpart here.
+template<Evaluation E>
+force_inline constexpr auto use_cxm() -> bool
 {
-    if constexpr (is_vector_v<X>) {
+    return E == Evaluation::approximate || std::is_constant_evaluated();
+}
+
+} // namespace detail
+
+template<Evaluation E = Evaluation::exact, typename X>
+force_inline constexpr auto abs(X x) -> X
+{
+    if (detail::use_cxm<E>()) {
+        return cxm::abs(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::abs(x);
     }
     else {
@@ -22,10 +57,13 @@ force_inline auto abs(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto trunc(X x) -> X
+template<Evaluation E = Evaluation::exact, typename X>
+force_inline constexpr auto trunc(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::trunc(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::trunc(x);
     }
     else {
@@ -33,10 +71,13 @@ force_inline auto trunc(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto floor(X x) -> X
+template<Evaluation E = Evaluation::exact, typename X>
+force_inline constexpr auto floor(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::floor(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::floor(x);
     }
     else {
@@ -44,10 +85,13 @@ force_inline auto floor(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto ceil(X x) -> X
+template<Evaluation E = Evaluation::exact, typename X>
+force_inline constexpr auto ceil(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::ceil(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::ceil(x);
     }
     else {
@@ -55,10 +99,16 @@ force_inline auto ceil(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto round(X x) -> X
+/// Rounds half away from zero, like std::round, under both policies and during constant evaluation. (cxm::round
+/// rounds half up.) Rounding is exact, so Evaluation::approximate only swaps the library call for trunc and sign.
+template<Evaluation E = Evaluation::exact, typename X>
+force_inline constexpr auto round(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (E == Evaluation::approximate || std::is_constant_evaluated()) {
+        const auto t = cxm::trunc(x);
+        return select(cxm::abs(x - t) >= X(0.5), t + cxm::sign(x), t); // x - t is exact.
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::round(x);
     }
     else {
@@ -66,10 +116,13 @@ force_inline auto round(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto fmod(X x, X y) -> X
+template<Evaluation E = Evaluation::exact, typename X>
+force_inline constexpr auto fmod(X x, X y) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::fmod(x, y);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::fmod(x, y);
     }
     else {
@@ -77,10 +130,13 @@ force_inline auto fmod(X x, X y) -> X
     }
 }
 
-template<typename X>
-force_inline auto cos(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto cos(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::cos<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::cos(x);
     }
     else {
@@ -88,10 +144,13 @@ force_inline auto cos(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto sin(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto sin(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::sin<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::sin(x);
     }
     else {
@@ -99,10 +158,13 @@ force_inline auto sin(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto tan(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto tan(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::tan<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::tan(x);
     }
     else {
@@ -110,10 +172,13 @@ force_inline auto tan(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto acos(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto acos(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::acos<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::acos(x);
     }
     else {
@@ -121,10 +186,13 @@ force_inline auto acos(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto asin(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto asin(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::asin<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::asin(x);
     }
     else {
@@ -132,10 +200,13 @@ force_inline auto asin(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto atan(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto atan(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::atan<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::atan(x);
     }
     else {
@@ -143,10 +214,41 @@ force_inline auto atan(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto cosh(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto atan2(X y, X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::atan2<P>(y, x);
+    }
+    else if constexpr (is_vector_v<X>) {
+        return simd::atan2(y, x);
+    }
+    else {
+        return std::atan2(y, x);
+    }
+}
+
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto hypot(X x, X y) -> X
+{
+    if (detail::use_cxm<E>()) {
+        return cxm::hypot<P>(x, y);
+    }
+    else if constexpr (is_vector_v<X>) {
+        return simd::hypot(x, y);
+    }
+    else {
+        return std::hypot(x, y);
+    }
+}
+
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto cosh(X x) -> X
+{
+    if (detail::use_cxm<E>()) {
+        return cxm::cosh<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::cosh(x);
     }
     else {
@@ -154,10 +256,13 @@ force_inline auto cosh(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto sinh(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto sinh(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::sinh<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::sinh(x);
     }
     else {
@@ -165,10 +270,13 @@ force_inline auto sinh(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto tanh(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto tanh(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::tanh<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::tanh(x);
     }
     else {
@@ -220,10 +328,13 @@ force_inline auto erf(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto exp2(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto exp2(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::exp2<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::exp2(x);
     }
     else {
@@ -231,10 +342,13 @@ force_inline auto exp2(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto log2(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto log2(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::log2<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::log2(x);
     }
     else {
@@ -242,10 +356,13 @@ force_inline auto log2(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto exp(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto exp(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::exp<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::exp(x);
     }
     else {
@@ -253,10 +370,13 @@ force_inline auto exp(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto log(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto log(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::log<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::log(x);
     }
     else {
@@ -264,10 +384,13 @@ force_inline auto log(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto log10(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto log10(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::log10<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::log10(x);
     }
     else {
@@ -275,10 +398,13 @@ force_inline auto log10(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto logB(X b, X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto logB(X b, X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::logB<P>(b, x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::log2(x) / simd::log2(b);
     }
     else {
@@ -286,10 +412,13 @@ force_inline auto logB(X b, X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto pow(X x, X y) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto pow(X x, X y) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::pow<P>(x, y);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::pow(x, y);
     }
     else {
@@ -297,10 +426,13 @@ force_inline auto pow(X x, X y) -> X
     }
 }
 
-template<typename X>
-force_inline auto sqrt(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto sqrt(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::sqrt<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::sqrt(x);
     }
     else {
@@ -308,10 +440,13 @@ force_inline auto sqrt(X x) -> X
     }
 }
 
-template<typename X>
-force_inline auto cbrt(X x) -> X
+template<Evaluation E = Evaluation::exact, Precision P = default_precision_v<E>, typename X>
+force_inline constexpr auto cbrt(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::cbrt<P>(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::cbrt(x);
     }
     else {
@@ -319,10 +454,13 @@ force_inline auto cbrt(X x) -> X
     }
 }
 
-template<typename X, typename C>
-force_inline auto min(X a, C b) -> X
+template<Evaluation E = Evaluation::exact, typename X, typename C>
+force_inline constexpr auto min(X a, C b) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::min(a, b);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::min(a, X(b));
     }
     else {
@@ -330,10 +468,13 @@ force_inline auto min(X a, C b) -> X
     }
 }
 
-template<typename X, typename C>
-force_inline auto max(X a, C b) -> X
+template<Evaluation E = Evaluation::exact, typename X, typename C>
+force_inline constexpr auto max(X a, C b) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::max(a, b);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::max(a, X(b));
     }
     else {
@@ -341,10 +482,13 @@ force_inline auto max(X a, C b) -> X
     }
 }
 
-template<typename X, typename C>
-force_inline auto clamp(X x, C a, C b) -> X
+template<Evaluation E = Evaluation::exact, typename X, typename C>
+force_inline constexpr auto clamp(X x, C a, C b) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::clamp(x, a, b);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::clamp(x, X(a), X(b));
     }
     else {
@@ -352,10 +496,13 @@ force_inline auto clamp(X x, C a, C b) -> X
     }
 }
 
-template<typename X>
-force_inline auto sign(X x) -> X
+template<Evaluation E = Evaluation::exact, typename X>
+force_inline constexpr auto sign(X x) -> X
 {
-    if constexpr (is_vector_v<X>) {
+    if (detail::use_cxm<E>()) {
+        return cxm::sign(x);
+    }
+    else if constexpr (is_vector_v<X>) {
         return simd::sign(x);
     }
     else {
@@ -364,17 +511,24 @@ force_inline auto sign(X x) -> X
 }
 
 template<typename X>
-force_inline auto wrap(X x) -> X
+force_inline constexpr auto wrap(X x) -> X
 {
     return cxm::wrap(x);
 }
 
 template<typename X, typename B>
-force_inline auto wrap(X x, B a, B b) -> X
+force_inline constexpr auto wrap(X x, B a, B b) -> X
 {
     return cxm::wrap(x, a, b);
 }
 
+static_assert(round(-2.5) == -3.0);
+static_assert(round(0.49999997f) == 0.f);
+static_assert(round<Evaluation::approximate>(-2.5) == -3.0);
+static_assert(sqrt(2.0) == std::numbers::sqrt2);
+static_assert(abs_equal(sin(1.0), 0.8414709848078965, 1e-15));
+static_assert(abs_equal(exp2<Evaluation::approximate, Precision::fast>(0.5f), std::numbers::sqrt2_v<float>, 2e-4f));
+
 } // namespace vsl
 
 #endif /* _vsl_math_h */
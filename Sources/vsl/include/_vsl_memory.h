@@ -0,0 +1,462 @@
+#ifndef _vsl_memory_h
+#define _vsl_memory_h
+
+#include <algorithm>
+#include <atomic> // atomic_thread_fence
+#include <cassert>
+#include <cstddef>
+#include <cstring> // memcpy, memset
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "_vsl_core.h"
+#include "_vsl_utils.h" // to_bits, immintrin.h
+
+namespace vsl {
+
+/// The alignment of every Aligned_buffer and Arena allocation: a cache line, which also covers the widest vector
+/// register (AVX-512).
+inline constexpr size_t buffer_alignment = 64;
+
+namespace detail {
+
+constexpr auto align_up(size_t bytes, size_t alignment) -> size_t
+{
+    return (bytes + alignment - 1) / alignment * alignment;
+}
+
+/// n elements of T, rounded up to cover whole cache lines (and so whole registers of any width).
+template<typename T>
+constexpr auto padded_count(size_t n) -> size_t
+{
+    return (align_up(n * sizeof(T), buffer_alignment) + sizeof(T) - 1) / sizeof(T);
+}
+
+static_assert(padded_count<float>(0) == 0);
+static_assert(padded_count<float>(1) == 16);
+static_assert(padded_count<float>(16) == 16);
+static_assert(padded_count<double>(17) == 24);
+static_assert(padded_count<char[24]>(1) == 3);
+
+} // namespace detail
+
+// MARK: - Loads and stores
+
+// Loads and stores of a whole X (a scalar or a vector) at p, which points at scalars. The intrinsics are picked by the
+// instruction set of the translation unit; without one, each falls back to per-member code that has the same effect.
+
+/// The per-member index type for gather and scatter: int4 for a float4, long2 for a double2.
+template<typename X>
+using index_t = signed_counterpart_t<X>;
+
+/// Loads from any address.
+template<typename X>
+force_inline auto load(const scalar_t<X>* p) -> X
+{
+    X x;
+    std::memcpy(&x, p, sizeof(X));
+    return x;
+}
+
+/// Loads from an address aligned to sizeof(X).
+template<typename X>
+force_inline auto load_aligned(const scalar_t<X>* p) -> X
+{
+    return load<X>(static_cast<const scalar_t<X>*>(__builtin_assume_aligned(p, sizeof(X))));
+}
+
+/// Stores to any address.
+template<typename X>
+force_inline auto store(scalar_t<X>* p, X x) -> void
+{
+    std::memcpy(p, &x, sizeof(X));
+}
+
+/// Stores to an address aligned to sizeof(X).
+template<typename X>
+force_inline auto store_aligned(scalar_t<X>* p, X x) -> void
+{
+    store(static_cast<scalar_t<X>*>(__builtin_assume_aligned(p, sizeof(X))), x);
+}
+
+/**
+ * @brief Stores to an address aligned to sizeof(X) without bringing the line into the cache (movntps).
+ *
+ * For large outputs that won't be read again soon. Call stream_fence() before another thread reads them.
+ */
+template<typename X>
+force_inline auto store_streaming(scalar_t<X>* p, X x) -> void
+{
+#if defined(__SSE2__)
+    using S = scalar_t<X>;
+    if constexpr (is_vector_v<X> && sizeof(X) == 16) {
+        if constexpr (sizeof(S) == 4) {
+            return _mm_stream_ps(p, __builtin_bit_cast(__m128, x));
+        }
+        else {
+            return _mm_stream_pd(p, __builtin_bit_cast(__m128d, x));
+        }
+    }
+#if defined(__AVX__)
+    else if constexpr (is_vector_v<X> && sizeof(X) == 32) {
+        if constexpr (sizeof(S) == 4) {
+            return _mm256_stream_ps(p, __builtin_bit_cast(__m256, x));
+        }
+        else {
+            return _mm256_stream_pd(p, __builtin_bit_cast(__m256d, x));
+        }
+    }
+#endif
+#if defined(__AVX512F__)
+    else if constexpr (is_vector_v<X> && sizeof(X) == 64) {
+        if constexpr (sizeof(S) == 4) {
+            return _mm512_stream_ps(p, __builtin_bit_cast(__m512, x));
+        }
+        else {
+            return _mm512_stream_pd(p, __builtin_bit_cast(__m512d, x));
+        }
+    }
+#endif
+    else if constexpr (is_vector_v<X>) {
+        // Wider than the registers: one half at a time.
+        store_streaming(p, detail::half<0>(x));
+        return store_streaming(p + num_members_v<X> / 2, detail::half<1>(x));
+    }
+#endif
+    store_aligned(p, x);
+}
+
+/// Orders streaming stores before the stores that follow, e.g. a flag that tells another thread the buffer is ready.
+force_inline auto stream_fence() -> void
+{
+#if defined(__SSE2__)
+    _mm_sfence();
+#else
+    std::atomic_thread_fence(std::memory_order_release);
+#endif
+}
+
+/// A mask of the members below n, e.g. for the tail of a buffer.
+template<typename X>
+force_inline constexpr auto mask_first(size_t n) -> mask_t<X>
+{
+    if constexpr (is_vector_v<X>) {
+        return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+            using M = scalar_t<mask_t<X>>;
+            return mask_t<X>{M(I)...} < M(std::min(n, num_members_v<X>));
+        }(std::make_index_sequence<num_members_v<X>>{});
+    }
+    else {
+        return bool_to_mask(n > 0);
+    }
+}
+
+static_assert(to_bits(mask_first<float4>(3)) == 0b0111);
+static_assert(to_bits(mask_first<double2>(size_t(-1))) == 0b11);
+
+/// Loads the members where mask is set. The others are zero, and their memory isn't touched, so it may be unmapped.
+template<typename X>
+force_inline auto load_masked(const scalar_t<X>* p, mask_t<X> mask) -> X
+{
+    if constexpr (is_vector_v<X>) {
+#if defined(__AVX__)
+        using S = scalar_t<X>; // (AVX-512 implies AVX.)
+#endif
+#if defined(__AVX512F__)
+        if constexpr (sizeof(X) == 64 && sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm512_maskz_loadu_ps(__mmask16(to_bits(mask)), p));
+        }
+        else if constexpr (sizeof(X) == 64) {
+            return __builtin_bit_cast(X, _mm512_maskz_loadu_pd(__mmask8(to_bits(mask)), p));
+        }
+#endif
+#if defined(__AVX__)
+        if constexpr (sizeof(X) == 32 && sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm256_maskload_ps(p, __builtin_bit_cast(__m256i, mask)));
+        }
+        else if constexpr (sizeof(X) == 32) {
+            return __builtin_bit_cast(X, _mm256_maskload_pd(p, __builtin_bit_cast(__m256i, mask)));
+        }
+        else if constexpr (sizeof(X) == 16 && sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm_maskload_ps(p, __builtin_bit_cast(__m128i, mask)));
+        }
+        else if constexpr (sizeof(X) == 16) {
+            return __builtin_bit_cast(X, _mm_maskload_pd(p, __builtin_bit_cast(__m128i, mask)));
+        }
+#endif
+
+        auto x = X(0);
+        for_each_set(mask, [&](size_t i) __attribute__((always_inline)) { set_member(x, i, p[i]); });
+        return x;
+    }
+    else {
+        return mask_to_bool(mask) ? *p : X(0);
+    }
+}
+
+/// Stores the members where mask is set, leaving the memory of the others untouched.
+template<typename X>
+force_inline auto store_masked(scalar_t<X>* p, X x, mask_t<X> mask) -> void
+{
+    if constexpr (is_vector_v<X>) {
+#if defined(__AVX__)
+        using S = scalar_t<X>; // (AVX-512 implies AVX.)
+#endif
+#if defined(__AVX512F__)
+        if constexpr (sizeof(X) == 64 && sizeof(S) == 4) {
+            return _mm512_mask_storeu_ps(p, __mmask16(to_bits(mask)), __builtin_bit_cast(__m512, x));
+        }
+        else if constexpr (sizeof(X) == 64) {
+            return _mm512_mask_storeu_pd(p, __mmask8(to_bits(mask)), __builtin_bit_cast(__m512d, x));
+        }
+#endif
+#if defined(__AVX__)
+        if constexpr (sizeof(X) == 32 && sizeof(S) == 4) {
+            return _mm256_maskstore_ps(p, __builtin_bit_cast(__m256i, mask), __builtin_bit_cast(__m256, x));
+        }
+        else if constexpr (sizeof(X) == 32) {
+            return _mm256_maskstore_pd(p, __builtin_bit_cast(__m256i, mask), __builtin_bit_cast(__m256d, x));
+        }
+        else if constexpr (sizeof(X) == 16 && sizeof(S) == 4) {
+            return _mm_maskstore_ps(p, __builtin_bit_cast(__m128i, mask), __builtin_bit_cast(__m128, x));
+        }
+        else if constexpr (sizeof(X) == 16) {
+            return _mm_maskstore_pd(p, __builtin_bit_cast(__m128i, mask), __builtin_bit_cast(__m128d, x));
+        }
+#endif
+
+        for_each_set(mask, [&](size_t i) __attribute__((always_inline)) { p[i] = x[i]; });
+    }
+    else if (mask_to_bool(mask)) {
+        *p = x;
+    }
+}
+
+/// Member i is base[index[i]].
+template<typename X>
+force_inline auto gather(const scalar_t<X>* base, index_t<X> index) -> X
+{
+    if constexpr (is_vector_v<X>) {
+#if defined(__AVX2__)
+        using S = scalar_t<X>; // (AVX-512 implies AVX2.)
+#endif
+#if defined(__AVX512F__)
+        if constexpr (sizeof(X) == 64 && sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm512_i32gather_ps(__builtin_bit_cast(__m512i, index), base, 4));
+        }
+        else if constexpr (sizeof(X) == 64) {
+            return __builtin_bit_cast(X, _mm512_i64gather_pd(__builtin_bit_cast(__m512i, index), base, 8));
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (sizeof(X) == 32 && sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm256_i32gather_ps(base, __builtin_bit_cast(__m256i, index), 4));
+        }
+        else if constexpr (sizeof(X) == 32) {
+            return __builtin_bit_cast(X, _mm256_i64gather_pd(base, __builtin_bit_cast(__m256i, index), 8));
+        }
+        else if constexpr (sizeof(X) == 16 && sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm_i32gather_ps(base, __builtin_bit_cast(__m128i, index), 4));
+        }
+        else if constexpr (sizeof(X) == 16) {
+            return __builtin_bit_cast(X, _mm_i64gather_pd(base, __builtin_bit_cast(__m128i, index), 8));
+        }
+#endif
+
+        return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+            return X{base[index[I]]...};
+        }(std::make_index_sequence<num_members_v<X>>{});
+    }
+    else {
+        return base[index];
+    }
+}
+
+/// base[index[i]] = x[i], in member order, so the highest member wins where indices repeat.
+template<typename X>
+force_inline auto scatter(scalar_t<X>* base, index_t<X> index, X x) -> void
+{
+    if constexpr (is_vector_v<X>) {
+#if defined(__AVX512F__)
+        using S = scalar_t<X>;
+        if constexpr (sizeof(X) == 64 && sizeof(S) == 4) {
+            return _mm512_i32scatter_ps(base, __builtin_bit_cast(__m512i, index), __builtin_bit_cast(__m512, x), 4);
+        }
+        else if constexpr (sizeof(X) == 64) {
+            return _mm512_i64scatter_pd(base, __builtin_bit_cast(__m512i, index), __builtin_bit_cast(__m512d, x), 8);
+        }
+#if defined(__AVX512VL__)
+        else if constexpr (sizeof(X) == 32 && sizeof(S) == 4) {
+            return _mm256_i32scatter_ps(base, __builtin_bit_cast(__m256i, index), __builtin_bit_cast(__m256, x), 4);
+        }
+        else if constexpr (sizeof(X) == 32) {
+            return _mm256_i64scatter_pd(base, __builtin_bit_cast(__m256i, index), __builtin_bit_cast(__m256d, x), 8);
+        }
+        else if constexpr (sizeof(S) == 4) {
+            return _mm_i32scatter_ps(base, __builtin_bit_cast(__m128i, index), __builtin_bit_cast(__m128, x), 4);
+        }
+        else {
+            return _mm_i64scatter_pd(base, __builtin_bit_cast(__m128i, index), __builtin_bit_cast(__m128d, x), 8);
+        }
+#endif
+#endif
+
+        for (size_t i = 0; i < num_members_v<X>; ++i) {
+            base[index[i]] = x[i];
+        }
+    }
+    else {
+        base[index] = x;
+    }
+}
+
+// MARK: - Aligned_buffer
+
+/**
+ @brief A fixed-size heap buffer of n T, aligned to `buffer_alignment` and zero-padded to a whole cache line.
+
+ Past size() there are padded_size() - size() zeros, so a kernel can load and store the tail as a full register
+ without a scalar loop. It converts to `std::span<T>` (of size()), so it can be passed straight to the `vsl::` and
+ `vsl::dispatch::` block functions. T must be trivially copyable; new buffers are zero-filled.
+ */
+template<typename T>
+class Aligned_buffer {
+public:
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    using value_type = T;
+
+    Aligned_buffer() = default;
+
+    explicit Aligned_buffer(size_t n) : _size{n}, _padded_size{detail::padded_count<T>(n)}
+    {
+        if (_padded_size > 0) {
+            _data = static_cast<T*>(::operator new(_padded_size * sizeof(T), std::align_val_t{_alignment}));
+            std::memset(static_cast<void*>(_data), 0, _padded_size * sizeof(T));
+        }
+    }
+
+    Aligned_buffer(const Aligned_buffer& other) : Aligned_buffer(other._size)
+    {
+        if (_size > 0) {
+            std::memcpy(static_cast<void*>(_data), other._data, _size * sizeof(T));
+        }
+    }
+
+    Aligned_buffer(Aligned_buffer&& other) noexcept
+        : _data{std::exchange(other._data, nullptr)},
+          _size{std::exchange(other._size, 0)},
+          _padded_size{std::exchange(other._padded_size, 0)}
+    {}
+
+    auto operator=(Aligned_buffer other) noexcept -> Aligned_buffer&
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_padded_size, other._padded_size);
+        return *this;
+    }
+
+    ~Aligned_buffer()
+    {
+        if (_data) {
+            ::operator delete(static_cast<void*>(_data), std::align_val_t{_alignment});
+        }
+    }
+
+    auto size() const -> size_t { return _size; }
+    auto empty() const -> bool { return _size == 0; }
+
+    /// size() rounded up to a whole cache line. The members past size() start as zero.
+    auto padded_size() const -> size_t { return _padded_size; }
+
+    auto data() -> T* { return _data; }
+    auto data() const -> const T* { return _data; }
+
+    auto begin() -> T* { return _data; }
+    auto begin() const -> const T* { return _data; }
+    auto end() -> T* { return _data + _size; }
+    auto end() const -> const T* { return _data + _size; }
+
+    auto operator[](size_t i) -> T& { return _data[i]; }
+    auto operator[](size_t i) const -> const T& { return _data[i]; }
+
+    /// The whole allocation, including the padding.
+    auto padded() -> std::span<T> { return {_data, _padded_size}; }
+    auto padded() const -> std::span<const T> { return {_data, _padded_size}; }
+
+    /// The members of a buffer of vectors, as one span of scalars.
+    auto scalars() -> std::span<scalar_t<T>> requires is_vector_v<T>
+    {
+        return {reinterpret_cast<scalar_t<T>*>(_data), _size * num_members_v<T>};
+    }
+
+    auto scalars() const -> std::span<const scalar_t<T>> requires is_vector_v<T>
+    {
+        return {reinterpret_cast<const scalar_t<T>*>(_data), _size * num_members_v<T>};
+    }
+
+private:
+    static constexpr size_t _alignment = std::max(buffer_alignment, alignof(T));
+
+    T* _data = nullptr;
+    size_t _size = 0;
+    size_t _padded_size = 0;
+};
+
+// MARK: - Arena
+
+/**
+ @brief A monotonic allocator: one aligned allocation up front, handed out in cache-line-aligned spans.
+
+ Meant for sizing a whole processing graph's scratch memory at setup, so nothing allocates in steady state. Spans
+ are zero-filled and padded like an Aligned_buffer's; they stay valid until reset() or the arena's destruction.
+ Add up `size_for<T>(n)` over every allocation to get the capacity to construct it with.
+ */
+class Arena {
+public:
+    Arena() = default;
+    explicit Arena(size_t bytes) : _buffer(detail::align_up(bytes, buffer_alignment)) {}
+
+    /// The bytes an allocate<T>(n) takes out of the arena.
+    template<typename T>
+    static constexpr auto size_for(size_t n) -> size_t
+    {
+        return detail::align_up(n * sizeof(T), buffer_alignment);
+    }
+
+    /// n zero-filled T, or an empty span (and an assertion) if the arena doesn't have size_for<T>(n) bytes left.
+    template<typename T>
+    auto allocate(size_t n) -> std::span<T>
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        static_assert(alignof(T) <= buffer_alignment);
+
+        const auto bytes = size_for<T>(n);
+        if (bytes > capacity() - _used) {
+            assert(!"Arena is out of memory");
+            return {};
+        }
+
+        const auto p = _buffer.data() + _used;
+        std::memset(p, 0, bytes);
+        _used += bytes;
+        return {reinterpret_cast<T*>(p), n};
+    }
+
+    /// Hands the whole capacity out again. Spans from earlier allocations must no longer be used.
+    auto reset() -> void { _used = 0; }
+
+    auto used() const -> size_t { return _used; }
+    auto capacity() const -> size_t { return _buffer.size(); }
+
+private:
+    Aligned_buffer<std::byte> _buffer;
+    size_t _used = 0;
+};
+
+} // namespace vsl
+
+#endif /* _vsl_memory_h */
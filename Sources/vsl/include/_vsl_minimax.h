@@ -0,0 +1,346 @@
+#ifndef _vsl_minimax_h
+#define _vsl_minimax_h
+
+#include <algorithm> // max, min
+#include <array>
+#include <numbers>
+#include <utility> // swap
+
+#include "_vsl_core.h"
+#include "_vsl_cxm.h" // cos for Chebyshev nodes, poly
+
+namespace vsl {
+
+/// Which error a minimax fit minimizes. Relative needs f to be nonzero on the whole interval.
+enum class Fit_error {
+    absolute, relative
+};
+
+/// A minimax polynomial, lowest order first, ready for cxm::poly.
+template<size_t N>
+struct Poly_fit {
+    std::array<double, N> coefficients;
+    double error; ///< The largest error found on the interval, with the rounded coefficients.
+};
+
+/// A minimax rational function p / q, ready for cxm::ratio. q[0] is 1.
+template<size_t N, size_t M>
+struct Ratio_fit {
+    std::array<double, N> p;
+    std::array<double, M> q;
+    double error; ///< The largest error found on the interval, with the rounded coefficients.
+};
+
+namespace detail {
+
+/// Solves a x = b for the augmented matrix [a | b], by Gaussian elimination with partial pivoting.
+template<size_t M>
+constexpr auto solve(std::array<std::array<double, M + 1>, M> a) -> std::array<double, M>
+{
+    for (size_t col = 0; col < M; ++col) {
+        auto pivot = col;
+        for (size_t row = col + 1; row < M; ++row) {
+            if (cxm::abs(a[row][col]) > cxm::abs(a[pivot][col])) {
+                pivot = row;
+            }
+        }
+        std::swap(a[col], a[pivot]);
+
+        for (size_t row = col + 1; row < M; ++row) {
+            const auto k = a[row][col] / a[col][col];
+            for (size_t j = col; j <= M; ++j) {
+                a[row][j] -= k * a[col][j];
+            }
+        }
+    }
+
+    auto x = std::array<double, M>{};
+    for (size_t i = M; i-- > 0;) {
+        auto s = a[i][M];
+        for (size_t j = i + 1; j < M; ++j) {
+            s -= a[i][j] * x[j];
+        }
+        x[i] = s / a[i][i];
+    }
+    return x;
+}
+
+/// c[0] + c[1] x + ..., by Horner's scheme in double. (Much cheaper to evaluate at compile time than cxm::poly.)
+template<size_t N>
+constexpr auto evaluate(const std::array<double, N>& c, double x) -> double
+{
+    auto y = c[N - 1];
+    for (size_t k = N - 1; k-- > 0;) {
+        y = y * x + c[k];
+    }
+    return y;
+}
+
+/// The coefficients in x of c(t), where t = a x + b.
+template<size_t N>
+constexpr auto substitute(const std::array<double, N>& c, double a, double b) -> std::array<double, N>
+{
+    auto r = std::array<double, N>{};
+    for (size_t k = N; k-- > 0;) {
+        // r = r * (a x + b) + c[k]
+        for (size_t j = N - 1; j > 0; --j) {
+            r[j] = a * r[j - 1] + b * r[j];
+        }
+        r[0] = b * r[0] + c[k];
+    }
+    return r;
+}
+
+/**
+ * @brief The Remez exchange algorithm for a rational function with numerator degree P and denominator degree Q.
+ *
+ * The fit is solved in t = -1...1 and converted to x at the end. Each iteration solves for the coefficients that
+ * make the error equal and alternating at P + Q + 2 reference points, then moves the reference to the extrema of
+ * the new error, found on a Chebyshev grid and refined by golden section search. For rational fits the system is
+ * nonlinear in the levelled error, which is iterated from the previous solution.
+ */
+template<size_t P, size_t Q, typename S, typename F>
+constexpr auto remez(F f, double lo, double hi, Fit_error kind) -> Ratio_fit<P + 1, Q + 1>
+{
+    static_assert(is_scalar_floating_point_v<S>);
+
+    constexpr auto n = P + Q + 2;
+    constexpr auto grid = size_t{512};
+    constexpr auto pi = std::numbers::pi;
+
+    const auto mid = (lo + hi) / 2;
+    const auto half = (hi - lo) / 2;
+    const auto f_t = [&](double t) { return double(f(mid + half * t)); };
+    const auto weight = [&](double y) { return kind == Fit_error::relative ? cxm::abs(y) : 1.0; };
+
+    auto p = std::array<double, P + 1>{};
+    auto q = std::array<double, Q + 1>{1};
+    const auto error_at = [&](double t, double y) {
+        return (detail::evaluate(p, t) / detail::evaluate(q, t) - y) / weight(y);
+    };
+
+    // f is sampled once, on a grid that's denser toward the ends, where the extrema crowd together.
+    // (The nodes -cos(g pi / (grid - 1)) come from the recurrence cos((g + 1) a) = 2 cos(a) cos(g a) - cos((g - 1) a),
+    // which is much cheaper to evaluate at compile time than a cos per node.)
+    auto grid_t = std::array<double, grid>{};
+    auto grid_y = std::array<double, grid>{};
+    const auto cos_step = cxm::cos<Precision::full>(pi / (grid - 1));
+    grid_t[0] = -1;
+    grid_t[1] = -cos_step;
+    for (size_t g = 2; g < grid; ++g) {
+        grid_t[g] = 2 * cos_step * grid_t[g - 1] - grid_t[g - 2];
+    }
+    grid_t[grid - 1] = 1;
+    auto scale = 0.0;
+    for (size_t g = 0; g < grid; ++g) {
+        grid_y[g] = f_t(grid_t[g]);
+        scale = std::max(scale, cxm::abs(grid_y[g]));
+    }
+
+    // Start from the Chebyshev extrema, where the error of a near-best fit alternates.
+    auto ref = std::array<double, n>{};
+    for (size_t i = 0; i < n; ++i) {
+        ref[i] = i == 0 ? -1 : i == n - 1 ? 1 : -cxm::cos<Precision::full>(pi * i / (n - 1));
+    }
+
+    // The fit with the smallest error on the grid so far, in case the exchange stalls.
+    auto best_p = p;
+    auto best_q = q;
+    auto best_error = -1.0;
+
+    auto grid_e = std::array<double, grid>{};
+    auto peaks = std::array<size_t, grid>{};
+
+    auto level = 0.0;
+    for (size_t iteration = 0; iteration < 16; ++iteration) {
+        auto ref_y = std::array<double, n>{};
+        for (size_t i = 0; i < n; ++i) {
+            ref_y[i] = f_t(ref[i]);
+        }
+
+        // p(t_i) - (y_i + s_i level) q(t_i) = 0 with q[0] = 1 and s_i = +-weight.
+        for (size_t pass = 0; pass < (Q == 0 ? 1 : 8); ++pass) {
+            auto a = std::array<std::array<double, n + 1>, n>{};
+            for (size_t i = 0; i < n; ++i) {
+                const auto s = (i % 2 == 0 ? 1 : -1) * weight(ref_y[i]);
+                auto tk = 1.0;
+                for (size_t k = 0; k <= P; ++k) {
+                    a[i][k] = tk;
+                    tk *= ref[i];
+                }
+                tk = ref[i];
+                for (size_t j = 1; j <= Q; ++j) {
+                    a[i][P + j] = -(ref_y[i] + s * level) * tk;
+                    tk *= ref[i];
+                }
+                a[i][n - 1] = -s;
+                a[i][n] = ref_y[i];
+            }
+
+            const auto x = detail::solve<n>(a);
+            for (size_t k = 0; k <= P; ++k) {
+                p[k] = x[k];
+            }
+            for (size_t j = 1; j <= Q; ++j) {
+                q[j] = x[P + j];
+            }
+            level = x[n - 1];
+        }
+
+        // The largest error in each run of one sign on the grid.
+        auto count = size_t{0};
+        auto grid_error = 0.0;
+        for (size_t g = 0; g < grid; ++g) {
+            grid_e[g] = error_at(grid_t[g], grid_y[g]);
+            grid_error = std::max(grid_error, cxm::abs(grid_e[g]));
+            if (count == 0 || (grid_e[g] > 0) != (grid_e[peaks[count - 1]] > 0)) {
+                peaks[count++] = g;
+            }
+            else if (cxm::abs(grid_e[g]) > cxm::abs(grid_e[peaks[count - 1]])) {
+                peaks[count - 1] = g;
+            }
+        }
+
+        if (best_error < 0 || grid_error < best_error) {
+            best_p = p;
+            best_q = q;
+            best_error = grid_error;
+        }
+        // Done when the error is levelled, or down to rounding (f is itself a polynomial of this degree).
+        if (grid_error <= cxm::abs(level) * (1 + 1e-6) || grid_error <= 1e-15 * scale) {
+            break;
+        }
+
+        // Keep n alternating peaks: drop the smaller end, or the smallest peak together with its smaller neighbor.
+        const auto size_of = [&](size_t k) { return cxm::abs(grid_e[peaks[k]]); };
+        const auto erase = [&](size_t k) {
+            for (size_t j = k + 1; j < count; ++j) {
+                peaks[j - 1] = peaks[j];
+            }
+            --count;
+        };
+        while (count > n) {
+            auto k = size_t{0};
+            for (size_t j = 1; j < count; ++j) {
+                k = size_of(j) < size_of(k) ? j : k;
+            }
+
+            if (count == n + 1 || k == 0 || k == count - 1) {
+                erase(count == n + 1 ? (size_of(0) < size_of(count - 1) ? 0 : count - 1) : k);
+            }
+            else {
+                const auto j = size_of(k - 1) < size_of(k + 1) ? k - 1 : k + 1;
+                erase(std::max(j, k));
+                erase(std::min(j, k));
+            }
+        }
+        if (count < n) {
+            break;
+        }
+
+        // Refine each peak between its grid neighbors.
+        for (size_t i = 0; i < n; ++i) {
+            const auto g = peaks[i];
+            const auto size_at = [&](double t) { return cxm::abs(error_at(t, f_t(t))); };
+
+            constexpr auto r = 0.6180339887498949;
+            auto a = grid_t[g == 0 ? 0 : g - 1];
+            auto b = grid_t[g == grid - 1 ? g : g + 1];
+            auto c = b - r * (b - a);
+            auto d = a + r * (b - a);
+            auto size_c = size_at(c);
+            auto size_d = size_at(d);
+            for (size_t step = 0; step < 16; ++step) {
+                if (size_c > size_d) {
+                    b = d, d = c, size_d = size_c;
+                    c = b - r * (b - a), size_c = size_at(c);
+                }
+                else {
+                    a = c, c = d, size_c = size_d;
+                    d = a + r * (b - a), size_d = size_at(d);
+                }
+            }
+
+            const auto size_g = cxm::abs(grid_e[g]);
+            const auto best = std::max(size_g, std::max(size_c, size_d));
+            ref[i] = best == size_g ? grid_t[g] : best == size_c ? c : d;
+        }
+    }
+
+    // To x, with q[0] = 1, rounded to S.
+    auto fit = Ratio_fit<P + 1, Q + 1>{detail::substitute(best_p, 1 / half, -mid / half),
+                                       detail::substitute(best_q, 1 / half, -mid / half), 0};
+    const auto q0 = fit.q[0];
+    for (auto& c : fit.p) {
+        c = double(S(c / q0));
+    }
+    for (auto& c : fit.q) {
+        c = double(S(c / q0));
+    }
+
+    const auto fit_error_at = [&](double t, double y) {
+        const auto x = mid + half * t;
+        return cxm::abs((detail::evaluate(fit.p, x) / detail::evaluate(fit.q, x) - y) / weight(y));
+    };
+    for (size_t g = 0; g < grid; ++g) {
+        fit.error = std::max(fit.error, fit_error_at(grid_t[g], grid_y[g]));
+    }
+    for (size_t i = 0; i < n; ++i) {
+        fit.error = std::max(fit.error, fit_error_at(ref[i], f_t(ref[i])));
+    }
+    return fit;
+}
+
+} // namespace detail
+
+/**
+ * @brief The minimax polynomial of the given degree for f on [lo, hi], computed at compile time.
+ *
+ * Assign the result to a constexpr variable and pass its coefficients to cxm::poly:
+ *
+ *     constexpr auto tanh = [](double x) { return 1 - 2 / (vsl::cxm::exp<vsl::precision::full>(2 * x) + 1); };
+ *     static constexpr auto fit = vsl::minimax<5, float>(tanh, -3, 3);
+ *     const auto y = vsl::cxm::poly(x, fit.coefficients);
+ *
+ * f must be callable in constant expressions (e.g. built on cxm:: functions at full precision). The coefficients
+ * are rounded to S, and error is measured after rounding. A fit usually converges in a few iterations of a few
+ * hundred calls to f, well under a second of compile time with GCC. Clang counts constexpr steps, and high degrees
+ * may need a higher -fconstexpr-steps.
+ *
+ * @tparam Degree The degree of the polynomial.
+ * @tparam S The scalar type the coefficients are rounded to.
+ */
+template<size_t Degree, typename S = double, typename F>
+constexpr auto minimax(F f, double lo, double hi, Fit_error kind = Fit_error::absolute) -> Poly_fit<Degree + 1>
+{
+    const auto fit = detail::remez<Degree, 0, S>(f, lo, hi, kind);
+    return {fit.p, fit.error};
+}
+
+/**
+ * @brief The minimax rational function p / q for f on [lo, hi], computed at compile time. Use it with cxm::ratio.
+ *
+ * High denominator degrees can put a pole in the interval, which shows as a large error.
+ *
+ * @tparam P The degree of the numerator.
+ * @tparam Q The degree of the denominator.
+ * @tparam S The scalar type the coefficients are rounded to.
+ */
+template<size_t P, size_t Q, typename S = double, typename F>
+constexpr auto minimax_ratio(F f, double lo, double hi, Fit_error kind = Fit_error::absolute) -> Ratio_fit<P + 1, Q + 1>
+{
+    return detail::remez<P, Q, S>(f, lo, hi, kind);
+}
+
+namespace detail {
+
+inline constexpr auto minimax_test_f = [](double x) { return x * x * x - 2 * x + 1; };
+
+} // namespace detail
+
+static_assert(minimax<3>(detail::minimax_test_f, -1, 2).error < 1e-12);
+static_assert(abs_equal(minimax<3>(detail::minimax_test_f, -1, 2).coefficients[1], -2.0, 1e-12));
+
+} // namespace vsl
+
+#endif /* _vsl_minimax_h */
@@ -1,108 +1,864 @@
 #ifndef _vsl_rand_h
 #define _vsl_rand_h
 
+#include <algorithm> // min
+#include <array>
+#include <cstdint>
+#include <cstring> // memcpy
 #include <limits>
+#include <numbers>
+#include <span>
+#include <type_traits> // conditional_t
+#include <utility> // index_sequence, pair
 
 #include "_vsl_core.h"
+#include "_vsl_cxm.h"   // log2, sincos_phase for the distributions
+#include "_vsl_math.h"  // sqrt
 #include "_vsl_utils.h" // unsigned_to_float
 
 namespace vsl {
 
+/**
+ * @brief The generator behind a Random_gen.
+ *
+ * - linear_congruential: one multiply-add per value. Cheapest, with the weakest low bits (which next() drops).
+ * - xorshift: three shift-xors per value.
+ * - counter: a hash of a per-lane key and a counter, so value n of any lane can be computed directly (seek(),
+ *   and discard() in O(1)). Three multiplies per value.
+ * - pcg: PCG RXS-M-XS on a 64-bit LCG, for much better statistics than the plain LCG at one extra multiply.
+ * - xoshiro128_plus: xoshiro128+, 128 bits of state per lane and only shifts, xors and an add. 32-bit lanes only.
+ * - xoshiro256_plus: xoshiro256+, 256 bits of state per lane.
+ *
+ * pcg and xoshiro256_plus make 64 bits per step. A float vector runs them on half as many 64-bit lanes, and each
+ * draw feeds two floats: `Random_gen<float4, pcg>` steps one ulong2.
+ */
 enum class Random_engine {
-    linear_congruential, xorshift
+    linear_congruential, xorshift, counter, pcg, xoshiro128_plus, xoshiro256_plus
 };
 
+namespace detail {
+
+// MARK: - Engines
+
+/// The LCG constants for U, a 32- or 64-bit unsigned scalar or vector.
+/// (see: https://audiodev.blog/random-numbers/)
+template<typename U>
+struct Lcg {
+    using T = scalar_t<U>;
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+
+    static constexpr auto multiplier = T(sizeof(T) == 4 ? 196314165 : 6364136223846793005);
+    static constexpr auto increment = T(sizeof(T) == 4 ? 907633515 : 1442695040888963407);
+};
+
+// see: https://en.wikipedia.org/wiki/Xorshift
+template<typename U>
+force_inline constexpr auto xorshift_step(U x) -> U
+{
+    if constexpr (sizeof(scalar_t<U>) == 4) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    }
+    else {
+        static_assert(sizeof(scalar_t<U>) == 8);
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x;
+    }
+}
+
+/// A bijective integer hash with good avalanche, for the counter engine and for deriving seeds.
+/// (lowbias32 for 32 bits, the splitmix64 finalizer for 64, see: https://nullprogram.com/blog/2018/07/31/)
+template<typename U>
+force_inline constexpr auto mix_bits(U x) -> U
+{
+    using T = scalar_t<U>;
+
+    if constexpr (sizeof(T) == 4) {
+        x ^= x >> 16;
+        x *= T(0x7feb352d);
+        x ^= x >> 15;
+        x *= T(0x846ca68b);
+        x ^= x >> 16;
+        return x;
+    }
+    else {
+        static_assert(sizeof(T) == 8);
+        x ^= x >> 30;
+        x *= T(0xbf58476d1ce4e5b9);
+        x ^= x >> 27;
+        x *= T(0x94d049bb133111eb);
+        x ^= x >> 31;
+        return x;
+    }
+}
+
+/// 2^bits / golden ratio, odd. Spreads consecutive counters across the hash's input.
+template<typename T>
+inline constexpr auto golden_v = T(sizeof(T) == 4 ? 0x9e3779b9 : 0x9e3779b97f4a7c15);
+
+// MARK: - Jump-ahead
+
+/// n LCG steps as a single step x -> a x + c, by repeated squaring. O(log n).
+template<typename T>
+struct Lcg_jump {
+    T a = 1;
+    T c = 0;
+
+    constexpr Lcg_jump() = default;
+
+    constexpr explicit Lcg_jump(uint64_t n)
+    {
+        auto step_a = Lcg<T>::multiplier;
+        auto step_c = Lcg<T>::increment;
+        for (; n != 0; n >>= 1) {
+            if (n & 1) {
+                a *= step_a;
+                c = c * step_a + step_c;
+            }
+            step_c *= step_a + 1;
+            step_a *= step_a;
+        }
+    }
+
+    template<typename U>
+    force_inline constexpr auto operator()(U x) const -> U { return a * x + c; }
+};
+
+/**
+ * @brief n xorshift steps as a single bit matrix. O(log n) matrix products.
+ *
+ * Each step is linear over GF(2), so it's a bits x bits matrix, stored as its columns: column j is the step applied
+ * to 1 << j.
+ */
+template<typename T>
+struct Xorshift_jump {
+    static constexpr auto bits = sizeof(T) * 8;
+
+    std::array<T, bits> columns{};
+
+    constexpr explicit Xorshift_jump(uint64_t n)
+    {
+        auto step = std::array<T, bits>{};
+        for (size_t j = 0; j < bits; ++j) {
+            columns[j] = T(1) << j;
+            step[j] = xorshift_step(T(1) << j);
+        }
+        for (; n != 0; n >>= 1) {
+            if (n & 1) {
+                columns = product(step, columns);
+            }
+            step = product(step, step);
+        }
+    }
+
+    constexpr auto operator()(T x) const -> T { return apply(columns, x); }
+
+    template<typename U> requires is_vector_v<U>
+    constexpr auto operator()(U x) const -> U
+    {
+        for (size_t i = 0; i < num_members_v<U>; ++i) {
+            set_member(x, i, apply(columns, x[i]));
+        }
+        return x;
+    }
+
+    /// x advanced n steps, without forming the matrix for n: one matrix-vector apply per set bit of n, against the
+    /// step's repeated squares. (Those are computed once per T, on first use.)
+    template<typename U>
+    static auto advance(U x, uint64_t n) -> U
+    {
+        static const auto squares = [] {
+            auto m = std::array<std::array<T, bits>, 64>{};
+            for (size_t j = 0; j < bits; ++j) {
+                m[0][j] = xorshift_step(T(1) << j);
+            }
+            for (size_t k = 1; k < m.size(); ++k) {
+                m[k] = product(m[k - 1], m[k - 1]);
+            }
+            return m;
+        }();
+        for (size_t k = 0; n != 0; ++k, n >>= 1) {
+            if (n & 1) {
+                if constexpr (is_vector_v<U>) {
+                    for (size_t i = 0; i < num_members_v<U>; ++i) {
+                        set_member(x, i, apply(squares[k], x[i]));
+                    }
+                }
+                else {
+                    x = apply(squares[k], x);
+                }
+            }
+        }
+        return x;
+    }
+
+private:
+
+    static constexpr auto apply(const std::array<T, bits>& m, T x) -> T
+    {
+        auto y = T{0};
+        for (size_t j = 0; j < bits; ++j, x >>= 1) {
+            y ^= m[j] & (T{0} - (x & 1));
+        }
+        return y;
+    }
+
+    static constexpr auto product(const std::array<T, bits>& a, const std::array<T, bits>& b) -> std::array<T, bits>
+    {
+        auto m = std::array<T, bits>{};
+        for (size_t j = 0; j < bits; ++j) {
+            m[j] = apply(a, b[j]);
+        }
+        return m;
+    }
+};
+
+/// PCG's output permutation of a 64-bit LCG state: a random shift, a multiply and a shift.
+/// (see: https://www.pcg-random.org/, pcg_output_rxs_m_xs_64_64)
+template<typename W>
+force_inline constexpr auto pcg_output(W state) -> W
+{
+    using T = scalar_t<W>;
+    static_assert(sizeof(T) == 8);
+
+    const auto word = ((state >> ((state >> 59) + 5)) ^ state) * T(12605985483714917081ull);
+    return (word >> 43) ^ word;
+}
+
+template<typename W>
+force_inline constexpr auto rotate_left(W x, int k) -> W
+{
+    constexpr auto bits = int(sizeof(scalar_t<W>) * 8);
+    return (x << k) | (x >> (bits - k));
+}
+
+/**
+ * @brief One step of xoshiro128+ (32-bit words) or xoshiro256+ (64-bit words). Returns s[0] + s[3] from before.
+ *
+ * (see: https://prng.di.unimi.it/)
+ */
+template<typename W>
+force_inline constexpr auto xoshiro_plus_step(std::array<W, 4>& s) -> W
+{
+    constexpr auto is_32 = sizeof(scalar_t<W>) == 4;
+
+    const auto result = s[0] + s[3];
+    const auto t = s[1] << (is_32 ? 9 : 17);
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotate_left(s[3], is_32 ? 11 : 45);
+
+    return result;
+}
+
+/// Advances a xoshiro state by 2^64 steps (xoshiro128+) or 2^128 (xoshiro256+), from the reference jump().
+template<typename W>
+constexpr auto xoshiro_jump(std::array<W, 4> s) -> std::array<W, 4>
+{
+    using T = scalar_t<W>;
+    constexpr auto jump = sizeof(T) == 4
+        ? std::array<T, 4>{T(0x8764000b), T(0xf542d2d3), T(0x6fa035c3), T(0x77f2db5b)}
+        : std::array<T, 4>{T(0x180ec6d33cfd0aba), T(0xd5a61266f0c9392c), T(0xa9582618e03fc9aa),
+                           T(0x39abdc4529b1661c)};
+
+    auto out = std::array<W, 4>{};
+    for (const auto word : jump) {
+        for (size_t b = 0; b < sizeof(T) * 8; ++b) {
+            if ((word >> b) & 1) {
+                for (size_t k = 0; k < 4; ++k) {
+                    out[k] ^= s[k];
+                }
+            }
+            xoshiro_plus_step(s);
+        }
+    }
+    return out;
+}
+
+// MARK: - State
+
+/// The 64-bit words behind X for the 64-bit engines: one per member of a double vector, one per pair of members of a
+/// float vector, or one per float.
+template<typename X>
+struct random_word { using type = ulong1; };
+
+template<typename X> requires (is_vector_v<X> && sizeof(scalar_t<X>) == 8)
+struct random_word<X> { using type = uint_t<X>; };
+
+template<typename X> requires (is_vector_v<X> && sizeof(scalar_t<X>) == 4)
+struct random_word<X> { using type = vector_of_t<ulong1, num_members_v<X> / 2>; };
+
+template<typename X>
+using random_word_t = typename random_word<X>::type;
+
+/// What a Random_gen<X, Engine> keeps per lane.
+template<typename X, Random_engine Engine>
+struct random_state { using type = uint_t<X>; };
+
+template<typename X>
+struct random_state<X, Random_engine::pcg> { using type = random_word_t<X>; };
+
+template<typename X>
+struct random_state<X, Random_engine::xoshiro128_plus> {
+    static_assert(sizeof(scalar_t<X>) == 4, "xoshiro128+ makes 32 bits per step: use xoshiro256_plus for doubles.");
+    using type = std::array<uint_t<X>, 4>;
+};
+
+template<typename X>
+struct random_state<X, Random_engine::xoshiro256_plus> { using type = std::array<random_word_t<X>, 4>; };
+
+template<typename X, Random_engine Engine>
+using random_state_t = typename random_state<X, Engine>::type;
+
+/// The bits of X from a 64-bit word: its two halves for a pair of floats, its top half for a single float.
+template<typename X, typename W>
+force_inline constexpr auto word_to_bits(W w) -> uint_t<X>
+{
+    if constexpr (std::is_same_v<W, uint_t<X>>) {
+        return w;
+    }
+    else if constexpr (is_vector_v<X>) {
+        return __builtin_bit_cast(uint_t<X>, w);
+    }
+    else {
+        return uint_t<X>(w >> 32);
+    }
+}
+
+/// Where mask selects, a; elsewhere b. Works for a mask over members of X and a state of X or of its 64-bit words,
+/// where a word is selected if either of its members is.
+template<typename X, typename State>
+force_inline auto select_state(mask_t<X> mask, const State& a, const State& b) -> State
+{
+    if constexpr (requires { std::tuple_size<State>::value; }) {
+        auto out = b;
+        for (size_t k = 0; k < out.size(); ++k) {
+            out[k] = select_state<X>(mask, a[k], b[k]);
+        }
+        return out;
+    }
+    else if constexpr (is_vector_v<X> && !std::is_same_v<State, uint_t<X>>) {
+        return select(__builtin_bit_cast(State, mask) != State(0), a, b);
+    }
+    else {
+        return select(mask_to_bool(mask), a, b);
+    }
+}
+
+/// A vector V (or scalar) with member i = f(i).
+template<typename V, typename F>
+force_inline auto make_lanes(F f) -> V
+{
+    if constexpr (is_vector_v<V>) {
+        auto v = V{};
+        for (size_t i = 0; i < num_members_v<V>; ++i) {
+            set_member(v, i, f(i));
+        }
+        return v;
+    }
+    else {
+        return f(0);
+    }
+}
+
+/// Stores x as value i of an unaligned buffer of X.
+template<typename X>
+force_inline auto store_value(scalar_t<X>* out, size_t i, X x) -> void
+{
+    std::memcpy(out + i * num_members_v<X>, &x, sizeof(X));
+}
+
+} // namespace detail
+
+/**
+ * @brief Uniform random numbers in [min, max), one per member of X.
+ *
+ * Each lane of a vector generator is its own stream. For the LCG, xorshift and pcg engines, lane i starts i/N of the
+ * way through the engine's period (N lanes), so lanes can't overlap for the first 2^32/N values (2^64/N for doubles
+ * and pcg). Lane 0, and so a scalar generator, starts at the seed itself. For the counter engine, each lane hashes a
+ * key derived from the seed and its index. The xoshiro engines seed lane 0 by hashing the seed and start each further
+ * lane 2^64 (xoshiro128+) or 2^128 (xoshiro256+) steps on, with the reference jump. The per-lane jumps are built
+ * once per type, on first construction, so later generators (one per voice, say) cost a few hundred nanoseconds.
+ *
+ * discard(n) skips n values in O(log n) (O(1) for the counter engine, O(n) for xoshiro), so threads or voices can
+ * take non-overlapping substreams of one seed.
+ */
 template<typename X, Random_engine Engine = Random_engine::linear_congruential>
 struct Random_gen {
     
     static constexpr auto default_seed = 808;
 
     using S = scalar_t<X>;
+    using State = detail::random_state_t<X, Engine>;
 
-    Random_gen() : _seed(default_seed), _min{0}, _max{1} {}
-    Random_gen(S min, S max, uint_t<X> seed = default_seed) : _seed{seed}, _min{min}, _max{max} {}
+    Random_gen() : Random_gen(0, 1) {}
+    Random_gen(S min, S max, uint_t<S> seed = default_seed) : _seed{_lane_seeds(seed)}, _min{min}, _max{max} {}
     
-    //
-    auto reset(mask_t<X> mask = true_mask_v<X>) -> void
+    /// Restarts the lanes in mask. For pcg and xoshiro256_plus with floats, the two members that share a 64-bit
+    /// lane restart together, if either is in mask.
+    force_inline auto reset(mask_t<X> mask = true_mask_v<X>) -> void
     {
-        const auto cond = mask_to_bool(mask);
-        _state = select(cond, _seed, _state);
+        _state = detail::select_state<X>(mask, _initial_state(), _state);
     }
     
-    auto next() -> X
+    force_inline auto next() -> X
     {
-        constexpr auto shift = ieee_exp_bits_v<S>;
-        constexpr auto one = uint_t<S>{1};
-        constexpr auto denom = one << (ieee_sig_bits_v<S> + 1);
-        constexpr auto mask = denom - 1;
+        return _to_range(_next(), _min, _max - _min);
+    }
+    
+    /// Fills a buffer with successive values of next(), member by member. The last value may be cut short.
+    force_inline auto fill(std::span<S> out) -> void
+    {
+        constexpr auto width = num_members_v<X>;
         
-        // We're doing the thing where we shift down so x doesn't get "rounded" on conversion.
-        const auto x = unsigned_to_float((_next<Engine>() >> shift) & mask);
-        constexpr auto y = unsigned_to_float(denom);
-        const auto norm = x / y;
+        const auto n = out.size();
+        const auto whole = n / width;
+        _fill(out.data(), whole);
         
-        return (_max - _min) * norm + _min;
+        if (whole * width < n) {
+            const auto x = next();
+            std::memcpy(out.data() + whole * width, &x, (n - whole * width) * sizeof(S));
+        }
+    }
+
+    /// Fills a buffer with successive values of next().
+    force_inline auto fill(std::span<X> out) -> void requires is_vector_v<X>
+    {
+        _fill(reinterpret_cast<S*>(out.data()), out.size());
+    }
+    
+    /// Skips the next n values of every lane, as if next() had been called n times.
+    auto discard(uint64_t n) -> void
+    {
+        if constexpr (Engine == Random_engine::linear_congruential) {
+            _state = detail::Lcg_jump<uint_t<S>>(n)(_state);
+        }
+        else if constexpr (Engine == Random_engine::xorshift) {
+            _state = detail::Xorshift_jump<uint_t<S>>::advance(_state, n);
+        }
+        else if constexpr (Engine == Random_engine::counter) {
+            _state += uint_t<S>(n);
+        }
+        else if constexpr (Engine == Random_engine::pcg) {
+            _state = detail::Lcg_jump<ulong1>(n)(_state);
+        }
+        else {
+            for (; n != 0; --n) {
+                detail::xoshiro_plus_step(_state);
+            }
+        }
+    }
+
+    /// Moves every lane to value n of its stream, counting from the seed. Only the counter engine can do this in
+    /// O(1); reset() and discard(n) do the same for the others.
+    force_inline auto seek(uint64_t n) -> void requires (Engine == Random_engine::counter)
+    {
+        _state = uint_t<X>(uint_t<S>(n));
     }
     
 private:
     
-    const uint_t<X> _seed = default_seed;
+    const State _seed;
     
     const S _min{};
     const S _max{};
     
-    uint_t<X> _state = _seed;
-    
-    template<Random_engine>
-    auto _next() -> uint_t<X> { static_assert(deferred_false_v<X>); }
-    
-    // see: https://audiodev.blog/random-numbers/
-    template<>
-    auto _next<Random_engine::linear_congruential>() -> uint_t<X>
+    State _state = _initial_state();
+
+    /// Each lane's starting state, or its key for the counter engine. See the class comment.
+    static auto _lane_seeds(uint_t<S> seed) -> State
     {
-        // 32-bit scalar type
-        if constexpr (sizeof(S) == 4) {
-            _state = 196314165 * _state + 907633515;
-            return _state;
+        if constexpr (Engine == Random_engine::counter) {
+            using U = uint_t<S>;
+            return detail::make_lanes<State>([seed](size_t lane) {
+                return detail::mix_bits(U(seed + lane * detail::golden_v<U>));
+            });
         }
-        // 64-bit scalar type
-        else if constexpr (sizeof(S) == 8) {
-            _state = 6364136223846793005 * _state + 1442695040888963407;
-            return _state;
+        else if constexpr (Engine == Random_engine::xoshiro128_plus || Engine == Random_engine::xoshiro256_plus) {
+            using W = typename State::value_type;
+            using T = scalar_t<W>;
+
+            auto lanes = std::array<std::array<T, 4>, num_members_v<W>>{};
+            for (size_t k = 0; k < 4; ++k) {
+                lanes[0][k] = detail::mix_bits(T(seed + (k + 1) * detail::golden_v<T>));
+            }
+            for (size_t i = 1; i < lanes.size(); ++i) {
+                lanes[i] = detail::xoshiro_jump(lanes[i - 1]);
+            }
+
+            auto state = State{};
+            for (size_t k = 0; k < 4; ++k) {
+                state[k] = detail::make_lanes<W>([&](size_t lane) { return lanes[lane][k]; });
+            }
+            return state;
         }
         else {
-            static_assert(deferred_false_v<S>);
+            using U = scalar_t<State>;
+            using Jump = std::conditional_t<Engine == Random_engine::xorshift, detail::Xorshift_jump<U>,
+                                            detail::Lcg_jump<U>>;
+            constexpr auto lanes = num_members_v<State>;
+            constexpr auto spacing = std::numeric_limits<U>::max() / lanes;
+
+            // The jumps depend only on the types, so they're built once, and a generator per voice costs one apply
+            // per lane. (A 64-bit xorshift jump is a 64x64 bit matrix, and takes hundreds of microseconds to build.)
+            static const auto jumps = []<size_t... Lane>(std::index_sequence<Lane...>) {
+                return std::array<Jump, lanes>{Jump(Lane * spacing)...};
+            }(std::make_index_sequence<lanes>{});
+            return detail::make_lanes<State>([seed](size_t lane) { return jumps[lane](U(seed)); });
+        }
+    }
+
+    /// How many values fill() computes per step. The LCG needs this many independent multiply-adds in flight to
+    /// cover their latency.
+    static constexpr size_t _fill_block = 4;
+
+    /// Writes count values of X to out, which needn't be aligned. The same values as count calls to next().
+    ///
+    /// The LCG computes _fill_block values at once, each from the current state with a precomputed jump
+    /// (see Lcg_jump), rather than each from the one before. The state and range stay in registers: out is an S*,
+    /// so the compiler can't assume stores to it leave the members alone.
+    force_inline auto _fill(S* out, size_t count) -> void
+    {
+        auto i = size_t{0};
+        
+        // Only the LCGs (and so pcg) are blocked. Xorshift and xoshiro steps are serial, and the counter's are
+        // already independent.
+        if constexpr (Engine == Random_engine::linear_congruential || Engine == Random_engine::pcg) {
+            using U = scalar_t<State>;
+
+            static constexpr auto jumps = [] {
+                auto jumps = std::array<detail::Lcg_jump<U>, _fill_block>{};
+                for (size_t k = 0; k < _fill_block; ++k) {
+                    jumps[k] = detail::Lcg_jump<U>(k + 1);
+                }
+                return jumps;
+            }();
+
+            const auto min = _min;
+            const auto range = _max - _min;
+            auto state = _state;
+
+            for (; i + _fill_block <= count; i += _fill_block) {
+                [&]<size_t... K>(std::index_sequence<K...>) __attribute__((always_inline)) {
+                    const auto states = std::array<State, _fill_block>{jumps[K](state)...};
+                    if constexpr (Engine == Random_engine::pcg) {
+                        // PCG outputs the state from before each step.
+                        const auto bits = std::array<uint_t<X>, _fill_block>{
+                            detail::word_to_bits<X>(detail::pcg_output(K == 0 ? state : states[K - 1]))...};
+                        (detail::store_value(out, i + K, _to_range(bits[K], min, range)), ...);
+                    }
+                    else {
+                        (detail::store_value(out, i + K, _to_range(states[K], min, range)), ...);
+                    }
+                    state = states[_fill_block - 1];
+                }(std::make_index_sequence<_fill_block>{});
+            }
+
+            _state = state;
+        }
+        
+        // A local copy, for the same reason.
+        auto gen = *this;
+        for (; i < count; ++i) {
+            detail::store_value(out, i, gen.next());
+        }
+        _state = gen._state;
+    }
+
+    /// Raw engine output to [min, min + range).
+    static force_inline auto _to_range(uint_t<X> bits, S min, S range) -> X
+    {
+        constexpr auto shift = ieee_exp_bits_v<S>;
+        constexpr auto one = uint_t<S>{1};
+        constexpr auto denom = one << (ieee_sig_bits_v<S> + 1);
+        constexpr auto mask = denom - 1;
+        
+        // We're doing the thing where we shift down so x doesn't get "rounded" on conversion.
+        const auto x = unsigned_to_float((bits >> shift) & mask);
+        constexpr auto y = unsigned_to_float(denom);
+        const auto norm = x / y;
+        
+        return range * norm + min;
+    }
+
+    force_inline auto _initial_state() const -> State
+    {
+        if constexpr (Engine == Random_engine::counter) {
+            return uint_t<X>(uint_t<S>{0});
+        }
+        else {
+            return _seed;
         }
     }
     
-    // see: https://en.wikipedia.org/wiki/Xorshift
-    template<>
-    auto _next<Random_engine::xorshift>() -> uint_t<X>
-    {
-        // 32-bit scalar type
-        if constexpr (sizeof(S) == 4) {
-            auto x = _state;
-            x ^= x << 13;
-            x ^= x >> 17;
-            x ^= x << 5;
-            _state = x;
-            return x;
+    force_inline auto _next() -> uint_t<X>
+    {
+        if constexpr (Engine == Random_engine::linear_congruential) {
+            _state = detail::Lcg<uint_t<X>>::multiplier * _state + detail::Lcg<uint_t<X>>::increment;
+            return _state;
         }
-        // 64-bit scalar type
-        else if constexpr (sizeof(S) == 8) {
-            auto x = _state;
-            x ^= x << 13;
-            x ^= x >> 7;
-            x ^= x << 17;
-            _state = x;
+        else if constexpr (Engine == Random_engine::xorshift) {
+            _state = detail::xorshift_step(_state);
+            return _state;
+        }
+        else if constexpr (Engine == Random_engine::counter) {
+            const auto x = detail::mix_bits((_state * detail::golden_v<uint_t<S>>) ^ _seed);
+            _state += 1;
             return x;
         }
+        else if constexpr (Engine == Random_engine::pcg) {
+            const auto x = detail::pcg_output(_state);
+            _state = detail::Lcg<State>::multiplier * _state + detail::Lcg<State>::increment;
+            return detail::word_to_bits<X>(x);
+        }
+        else if constexpr (Engine == Random_engine::xoshiro128_plus || Engine == Random_engine::xoshiro256_plus) {
+            return detail::word_to_bits<X>(detail::xoshiro_plus_step(_state));
+        }
         else {
-            static_assert(deferred_false_v<S>);
+            static_assert(deferred_false_v<X>);
         }
     }
 };
 
+// MARK: - Distributions
+
+namespace detail {
+
+/**
+ * @brief Calls f(k, u, v) for k = 0...count - 1, where u and v are the next two values of gen.
+ *
+ * The uniforms are drawn a chunk at a time with gen.fill, so they come from its blocked loop rather than one
+ * dependent step per value.
+ */
+template<typename X, Random_engine Engine, typename F>
+force_inline auto for_each_uniform_pair(Random_gen<X, Engine>& gen, size_t count, F f) -> void
+{
+    constexpr auto chunk = size_t{32};
+
+    X uniforms[2 * chunk];
+    for (size_t i = 0; i < count; i += chunk) {
+        const auto n = std::min(chunk, count - i);
+        gen.fill(std::span<X>(uniforms, 2 * n));
+        for (size_t k = 0; k < n; ++k) {
+            f(i + k, uniforms[2 * k], uniforms[2 * k + 1]);
+        }
+    }
 }
 
+/// gen.fill_values over the whole values in out, then one more next() cut short if out doesn't end on one.
+template<typename X, typename Gen>
+force_inline auto fill_members(Gen& gen, std::span<scalar_t<X>> out) -> void
+{
+    constexpr auto width = num_members_v<X>;
+
+    const auto whole = out.size() / width;
+    gen.fill_values(out.data(), whole);
+
+    if (whole * width < out.size()) {
+        const auto x = gen.next();
+        std::memcpy(out.data() + whole * width, &x, (out.size() - whole * width) * sizeof(scalar_t<X>));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Normally distributed random numbers, one independent stream per member of X.
+ *
+ * Box-Muller: each pair of uniforms u, v gives two values, sqrt(-2 ln(1 - u)) times cos and sin of 2 pi v. Every lane
+ * takes the same path, so there are no per-lane branches or rejection loops (unlike a Ziggurat). The sin half is kept
+ * for the following call. The tails are cut off where 1 - u bottoms out: about 5.8 sigma for float, 8.6 for double.
+ */
+template<typename X, Random_engine Engine = Random_engine::linear_congruential>
+struct Normal_gen {
+
+    using S = scalar_t<X>;
+
+    Normal_gen(S mean = 0, S stddev = 1, uint_t<S> seed = Random_gen<X, Engine>::default_seed)
+        : _uniform{0, 1, seed}, _mean{mean}, _stddev{stddev} {}
+
+    /// Restarts the lanes in mask. Values are made in pairs, so other lanes skip their pending second value.
+    force_inline auto reset(mask_t<X> mask = true_mask_v<X>) -> void
+    {
+        _uniform.reset(mask);
+        _has_spare = false;
+    }
+
+    force_inline auto next() -> X
+    {
+        if (_has_spare) {
+            _has_spare = false;
+            return _spare;
+        }
+
+        const auto u = _uniform.next();
+        const auto v = _uniform.next();
+        const auto [first, second] = _pair(u, v);
+        _spare = second;
+        _has_spare = true;
+        return first;
+    }
+
+    /// Fills a buffer with successive values of next(), member by member. The last value may be cut short.
+    force_inline auto fill(std::span<S> out) -> void { detail::fill_members<X>(*this, out); }
+
+    /// Fills a buffer with successive values of next().
+    force_inline auto fill(std::span<X> out) -> void requires is_vector_v<X>
+    {
+        fill_values(reinterpret_cast<S*>(out.data()), out.size());
+    }
+
+    /// Writes count values of X to out, which needn't be aligned.
+    force_inline auto fill_values(S* out, size_t count) -> void
+    {
+        auto i = size_t{0};
+        if (_has_spare && count > 0) {
+            detail::store_value(out, i++, next());
+        }
+
+        const auto pairs = (count - i) / 2;
+        detail::for_each_uniform_pair(_uniform, pairs, [&](size_t k, X u, X v) __attribute__((always_inline)) {
+            const auto [first, second] = _pair(u, v);
+            detail::store_value(out, i + 2 * k, first);
+            detail::store_value(out, i + 2 * k + 1, second);
+        });
+
+        if (i + 2 * pairs < count) {
+            detail::store_value(out, count - 1, next());
+        }
+    }
+
+private:
+
+    Random_gen<X, Engine> _uniform;
+    S _mean;
+    S _stddev;
+    X _spare{};
+    bool _has_spare = false;
+
+    force_inline auto _pair(X u, X v) const -> std::pair<X, X>
+    {
+        // 1 - u is in (0, 1], so the log is finite.
+        constexpr auto minus_2_ln2 = S(-2) * std::numbers::ln2_v<S>;
+        const auto r = _stddev * vsl::sqrt(minus_2_ln2 * cxm::log2(X(1) - u));
+        const auto [sin, cos] = cxm::sincos_phase(v);
+        return {r * cos + _mean, r * sin + _mean};
+    }
+};
+
+/// Exponentially distributed random numbers with the given rate (mean 1 / rate), one stream per member of X.
+/// Inverse CDF: -ln(1 - u) / rate.
+template<typename X, Random_engine Engine = Random_engine::linear_congruential>
+struct Exponential_gen {
+
+    using S = scalar_t<X>;
+
+    Exponential_gen(S rate = 1, uint_t<S> seed = Random_gen<X, Engine>::default_seed)
+        : _uniform{0, 1, seed}, _scale{-std::numbers::ln2_v<S> / rate} {}
+
+    force_inline auto reset(mask_t<X> mask = true_mask_v<X>) -> void { _uniform.reset(mask); }
+
+    force_inline auto next() -> X { return _from_uniform(_uniform.next()); }
+
+    /// Fills a buffer with successive values of next(), member by member. The last value may be cut short.
+    force_inline auto fill(std::span<S> out) -> void { detail::fill_members<X>(*this, out); }
+
+    /// Fills a buffer with successive values of next().
+    force_inline auto fill(std::span<X> out) -> void requires is_vector_v<X>
+    {
+        fill_values(reinterpret_cast<S*>(out.data()), out.size());
+    }
+
+    /// Writes count values of X to out, which needn't be aligned.
+    force_inline auto fill_values(S* out, size_t count) -> void
+    {
+        // Uniforms two at a time, so they come from the blocked fill like the others.
+        detail::for_each_uniform_pair(_uniform, count / 2, [&](size_t k, X u, X v) __attribute__((always_inline)) {
+            detail::store_value(out, 2 * k, _from_uniform(u));
+            detail::store_value(out, 2 * k + 1, _from_uniform(v));
+        });
+
+        if (count % 2 != 0) {
+            detail::store_value(out, count - 1, next());
+        }
+    }
+
+private:
+
+    Random_gen<X, Engine> _uniform;
+    S _scale;
+
+    force_inline auto _from_uniform(X u) const -> X { return _scale * cxm::log2(X(1) - u); }
+};
+
+/// Random numbers with a symmetric triangular distribution on (min, max), one stream per member of X: the mean of
+/// two uniforms. With min = -1 LSB and max = +1 LSB this is TPDF dither.
+template<typename X, Random_engine Engine = Random_engine::linear_congruential>
+struct Triangular_gen {
+
+    using S = scalar_t<X>;
+
+    Triangular_gen(S min = -1, S max = 1, uint_t<S> seed = Random_gen<X, Engine>::default_seed)
+        : _uniform{0, 1, seed}, _min{min}, _half_range{(max - min) / 2} {}
+
+    force_inline auto reset(mask_t<X> mask = true_mask_v<X>) -> void { _uniform.reset(mask); }
+
+    force_inline auto next() -> X
+    {
+        const auto u = _uniform.next();
+        const auto v = _uniform.next();
+        return _from_uniforms(u, v);
+    }
+
+    /// Fills a buffer with successive values of next(), member by member. The last value may be cut short.
+    force_inline auto fill(std::span<S> out) -> void { detail::fill_members<X>(*this, out); }
+
+    /// Fills a buffer with successive values of next().
+    force_inline auto fill(std::span<X> out) -> void requires is_vector_v<X>
+    {
+        fill_values(reinterpret_cast<S*>(out.data()), out.size());
+    }
+
+    /// Writes count values of X to out, which needn't be aligned.
+    force_inline auto fill_values(S* out, size_t count) -> void
+    {
+        detail::for_each_uniform_pair(_uniform, count, [&](size_t k, X u, X v) __attribute__((always_inline)) {
+            detail::store_value(out, k, _from_uniforms(u, v));
+        });
+    }
+
+private:
+
+    Random_gen<X, Engine> _uniform;
+    S _min;
+    S _half_range;
+
+    force_inline auto _from_uniforms(X u, X v) const -> X { return _half_range * (u + v) + _min; }
+};
+
+// The scalar engines and their jumps agree. (The 64-bit xorshift jump is checked in tests.cpp, since evaluating its
+// 64x64 matrices here would double the header's compile time.)
+static_assert([] {
+    using J = detail::Lcg_jump<uint32_t>;
+    auto x = uint32_t{808};
+    for (int i = 0; i < 1000; ++i) { x = J(1)(x); }
+    return x == J(1000)(808u) && J(0)(808u) == 808u;
+}());
+static_assert([] {
+    using J = detail::Xorshift_jump<uint32_t>;
+    auto x = uint32_t{808};
+    for (int i = 0; i < 100; ++i) { x = detail::xorshift_step(x); }
+    return x == J(100)(808u) && J(0)(808u) == 808u;
+}());
+
+} // namespace vsl
+
 #endif /* _vsl_rand_h */
@@ -0,0 +1,627 @@
+#ifndef _vsl_simd_h
+#define _vsl_simd_h
+
+// MARK: - Macros
+
+/// Mainly for DEBUG builds.
+/// see: https://gcc.gnu.org/onlinedocs/gcc/Inline.html
+#ifndef force_inline
+#ifdef __GNUC__
+#define force_inline inline __attribute__((always_inline))
+#else
+#define force_inline inline
+#endif
+#endif
+
+/// Use Apple's simd library when it is available, unless the portable backend is explicitly requested.
+#ifndef VSL_PORTABLE_SIMD
+#if defined(__APPLE__) && __has_include(<simd/simd.h>)
+#define VSL_PORTABLE_SIMD 0
+#else
+#define VSL_PORTABLE_SIMD 1
+#endif
+#endif
+
+#if !VSL_PORTABLE_SIMD
+
+#include <simd/simd.h>
+
+namespace vsl {
+
+/// The simd backend. (Apple's simd library.)
+namespace simd = ::simd;
+
+} // namespace vsl
+
+#else
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h> // sqrt
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // sqrt
+#endif
+
+#if !defined(__GNUC__)
+#error "The portable vsl simd backend requires GCC or Clang vector extensions."
+#endif
+
+/**
+ * The portable simd backend.
+ *
+ * This mirrors the subset of Apple's simd library that vsl uses, built on GCC/Clang vector extensions, so it
+ * compiles to SSE/AVX on x86-64 and NEON on AArch64. Vector types are thin wrappers around a native vector, which
+ * gives us scalar broadcasts (`float4(1.f)`, `x * 2.f`) and constexpr evaluation on both compilers.
+ */
+namespace vsl::simd {
+
+namespace detail {
+
+/// Maps a scalar type and a member count to a native vector type.
+/// (GCC ignores `vector_size` on dependent types, so each native type has to be spelled out.)
+template<typename T, std::size_t N>
+struct native_vector { static_assert(!std::is_void_v<T>, "No native vector type defined."); };
+
+#define _VSL_NATIVE_VECTOR(T, N) \
+    template<> \
+    struct native_vector<T, N> { typedef T type __attribute__((vector_size(sizeof(T) * N))); };
+
+// 128-bit
+_VSL_NATIVE_VECTOR(float, 4)
+_VSL_NATIVE_VECTOR(double, 2)
+_VSL_NATIVE_VECTOR(int, 4)
+_VSL_NATIVE_VECTOR(long, 2)
+_VSL_NATIVE_VECTOR(unsigned int, 4)
+_VSL_NATIVE_VECTOR(unsigned long, 2)
+
+// 256-bit
+_VSL_NATIVE_VECTOR(float, 8)
+_VSL_NATIVE_VECTOR(double, 4)
+_VSL_NATIVE_VECTOR(int, 8)
+_VSL_NATIVE_VECTOR(long, 4)
+_VSL_NATIVE_VECTOR(unsigned int, 8)
+_VSL_NATIVE_VECTOR(unsigned long, 4)
+
+// 512-bit
+_VSL_NATIVE_VECTOR(float, 16)
+_VSL_NATIVE_VECTOR(double, 8)
+_VSL_NATIVE_VECTOR(int, 16)
+_VSL_NATIVE_VECTOR(long, 8)
+_VSL_NATIVE_VECTOR(unsigned int, 16)
+_VSL_NATIVE_VECTOR(unsigned long, 8)
+
+#undef _VSL_NATIVE_VECTOR
+
+/// The signed integral type with the same size as T. (Comparison results are vectors of this type.)
+template<typename T>
+using mask_scalar_t = std::conditional_t<sizeof(T) == 4, int, long>;
+
+/// The unsigned integral type with the same size as T.
+template<typename T>
+using bits_scalar_t = std::conditional_t<sizeof(T) == 4, unsigned int, unsigned long>;
+
+/// The sign bit of T, as an unsigned integer.
+template<typename T>
+inline constexpr auto sign_bit_v = ~(~bits_scalar_t<T>{0} >> 1);
+
+} // namespace detail
+
+/**
+ * @brief A vector of N members of type T.
+ * @tparam T The scalar type.
+ * @tparam N The number of members.
+ */
+template<typename T, std::size_t N>
+struct Vec {
+    // Everything here is force_inline so it inlines into kernels compiled for another ISA. (See _vsl_dispatch.h.)
+    using native_type = typename detail::native_vector<T, N>::type;
+    using mask_type = Vec<detail::mask_scalar_t<T>, N>;
+
+    native_type v;
+
+    /// Like Apple's simd types, this leaves the members uninitialized. (`Vec{}` zero-initializes.)
+    constexpr Vec() = default;
+
+    force_inline constexpr Vec(native_type native) : v{native} {}
+
+    /// Broadcasts a scalar to every member.
+    force_inline constexpr Vec(T s) : Vec(s, std::make_index_sequence<N>{}) {}
+
+    /// Initializes every member.
+    template<typename... A>
+        requires (sizeof...(A) == N && N > 1 && (std::is_arithmetic_v<A> && ...))
+    force_inline constexpr Vec(A... a) : v{static_cast<T>(a)...} {}
+
+    // MARK: - Members
+
+    /// Members are read-only here, since Clang can't bind a reference to a native vector member. (Use `set` instead.)
+    force_inline constexpr auto operator[](std::size_t i) const -> T
+    {
+        // Clang 18 can't subscript native vectors during constant evaluation, but it can bit-cast them.
+        if (std::is_constant_evaluated()) {
+            return __builtin_bit_cast(std::array<T, N>, v)[i];
+        }
+        else {
+            return v[i];
+        }
+    }
+
+    force_inline constexpr auto set(std::size_t i, T s) -> void
+    {
+        // Members of native vectors can't be modified during constant evaluation.
+        if (std::is_constant_evaluated()) {
+            auto members = __builtin_bit_cast(std::array<T, N>, v);
+            members[i] = s;
+            v = __builtin_bit_cast(native_type, members);
+        }
+        else {
+            v[i] = s;
+        }
+    }
+
+    // MARK: - Arithmetic
+
+    friend force_inline constexpr auto operator+(Vec a) -> Vec { return a; }
+    friend force_inline constexpr auto operator-(Vec a) -> Vec { return -a.v; }
+    friend force_inline constexpr auto operator~(Vec a) -> Vec { return ~a.v; }
+
+    friend force_inline constexpr auto operator+(Vec a, Vec b) -> Vec { return a.v + b.v; }
+    friend force_inline constexpr auto operator-(Vec a, Vec b) -> Vec { return a.v - b.v; }
+    friend force_inline constexpr auto operator*(Vec a, Vec b) -> Vec { return a.v * b.v; }
+    friend force_inline constexpr auto operator/(Vec a, Vec b) -> Vec { return a.v / b.v; }
+    friend force_inline constexpr auto operator%(Vec a, Vec b) -> Vec { return a.v % b.v; }
+    friend force_inline constexpr auto operator&(Vec a, Vec b) -> Vec { return a.v & b.v; }
+    friend force_inline constexpr auto operator|(Vec a, Vec b) -> Vec { return a.v | b.v; }
+    friend force_inline constexpr auto operator^(Vec a, Vec b) -> Vec { return a.v ^ b.v; }
+    friend force_inline constexpr auto operator<<(Vec a, Vec b) -> Vec { return a.v << b.v; }
+    friend force_inline constexpr auto operator>>(Vec a, Vec b) -> Vec { return a.v >> b.v; }
+
+    force_inline constexpr auto operator+=(Vec b) -> Vec& { return *this = *this + b; }
+    force_inline constexpr auto operator-=(Vec b) -> Vec& { return *this = *this - b; }
+    force_inline constexpr auto operator*=(Vec b) -> Vec& { return *this = *this * b; }
+    force_inline constexpr auto operator/=(Vec b) -> Vec& { return *this = *this / b; }
+    force_inline constexpr auto operator%=(Vec b) -> Vec& { return *this = *this % b; }
+    force_inline constexpr auto operator&=(Vec b) -> Vec& { return *this = *this & b; }
+    force_inline constexpr auto operator|=(Vec b) -> Vec& { return *this = *this | b; }
+    force_inline constexpr auto operator^=(Vec b) -> Vec& { return *this = *this ^ b; }
+    force_inline constexpr auto operator<<=(Vec b) -> Vec& { return *this = *this << b; }
+    force_inline constexpr auto operator>>=(Vec b) -> Vec& { return *this = *this >> b; }
+
+    // MARK: - Comparison
+
+    // Comparisons return a mask: -1 where true, 0 where false.
+    friend force_inline constexpr auto operator==(Vec a, Vec b) -> mask_type { return _mask(a.v == b.v); }
+    friend force_inline constexpr auto operator!=(Vec a, Vec b) -> mask_type { return _mask(a.v != b.v); }
+    friend force_inline constexpr auto operator<(Vec a, Vec b) -> mask_type { return _mask(a.v < b.v); }
+    friend force_inline constexpr auto operator<=(Vec a, Vec b) -> mask_type { return _mask(a.v <= b.v); }
+    friend force_inline constexpr auto operator>(Vec a, Vec b) -> mask_type { return _mask(a.v > b.v); }
+    friend force_inline constexpr auto operator>=(Vec a, Vec b) -> mask_type { return _mask(a.v >= b.v); }
+
+private:
+
+    template<std::size_t... I>
+    force_inline constexpr Vec(T s, std::index_sequence<I...>) : v{((void)I, s)...} {}
+
+    // The native comparison type may be spelled differently from ours (e.g. long long vs long).
+    template<typename M>
+    force_inline static constexpr auto _mask(M m) -> mask_type
+    {
+        return (typename mask_type::native_type)m;
+    }
+};
+
+// MARK: - Types
+
+using float1 = float;
+using double1 = double;
+using int1 = int;
+using long1 = long;
+using uint1 = unsigned int;
+using ulong1 = unsigned long;
+
+using float4 = Vec<float, 4>;
+using double2 = Vec<double, 2>;
+using int4 = Vec<int, 4>;
+using long2 = Vec<long, 2>;
+using uint4 = Vec<unsigned int, 4>;
+using ulong2 = Vec<unsigned long, 2>;
+
+using float8 = Vec<float, 8>;
+using double4 = Vec<double, 4>;
+using int8 = Vec<int, 8>;
+using long4 = Vec<long, 4>;
+using uint8 = Vec<unsigned int, 8>;
+using ulong4 = Vec<unsigned long, 4>;
+
+using float16 = Vec<float, 16>;
+using double8 = Vec<double, 8>;
+using int16 = Vec<int, 16>;
+using long8 = Vec<long, 8>;
+using uint16 = Vec<unsigned int, 16>;
+using ulong8 = Vec<unsigned long, 8>;
+
+// MARK: - Helpers
+
+namespace detail {
+
+/// Applies a scalar function to every member.
+template<typename T, std::size_t N, typename F>
+force_inline constexpr auto map(F f, Vec<T, N> x) -> Vec<T, N>
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+        return Vec<T, N>(typename Vec<T, N>::native_type{f(x[I])...});
+    }(std::make_index_sequence<N>{});
+}
+
+/// Applies a binary scalar function to every pair of members.
+template<typename T, std::size_t N, typename F>
+force_inline constexpr auto map(F f, Vec<T, N> x, Vec<T, N> y) -> Vec<T, N>
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+        return Vec<T, N>(typename Vec<T, N>::native_type{f(x[I], y[I])...});
+    }(std::make_index_sequence<N>{});
+}
+
+/// Converts a single member to C.
+/// Out-of-range floating-point values give the smallest C, like x86 does, instead of failing constant evaluation.
+template<typename C, typename T>
+force_inline constexpr auto convert_member(T s) -> C
+{
+    if constexpr (std::is_floating_point_v<T> && std::is_integral_v<C>) {
+        constexpr auto lo = static_cast<T>(std::numeric_limits<C>::min());
+        constexpr auto hi = -2 * static_cast<T>(std::numeric_limits<std::make_signed_t<C>>::min());
+        if (!(s > lo - 1 && s < hi)) {
+            return std::numeric_limits<C>::min();
+        }
+    }
+    return static_cast<C>(s);
+}
+
+/// Reinterprets a vector as a vector of unsigned integers of the same size.
+template<typename T, std::size_t N>
+force_inline constexpr auto as_bits(Vec<T, N> x)
+{
+    return __builtin_bit_cast(Vec<bits_scalar_t<T>, N>, x);
+}
+
+} // namespace detail
+
+// MARK: - Logic
+
+/// For each bit, selects `y` if the bit is set in `mask`, otherwise `x`.
+template<typename T, typename M, std::size_t N>
+    requires (sizeof(T) == sizeof(M))
+force_inline constexpr auto bitselect(Vec<T, N> x, Vec<T, N> y, Vec<M, N> mask) -> Vec<T, N>
+{
+    const auto m = detail::as_bits(mask);
+    return __builtin_bit_cast(Vec<T, N>, (detail::as_bits(x) & ~m) | (detail::as_bits(y) & m));
+}
+
+/// True if the high bit of any member is set.
+template<typename T, std::size_t N>
+force_inline constexpr auto any(Vec<T, N> x) -> bool
+{
+    const auto signs = __builtin_bit_cast(Vec<detail::mask_scalar_t<T>, N>, x) < 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        if (signs[i]) { return true; }
+    }
+    return false;
+}
+
+/// True if the high bit of every member is set.
+template<typename T, std::size_t N>
+force_inline constexpr auto all(Vec<T, N> x) -> bool
+{
+    const auto signs = __builtin_bit_cast(Vec<detail::mask_scalar_t<T>, N>, x) < 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        if (!signs[i]) { return false; }
+    }
+    return true;
+}
+
+// MARK: - Conversions
+
+/// Converts each member to C. (Floating-point to integral conversions round toward zero.)
+template<typename C, typename T, std::size_t N>
+force_inline constexpr auto convert(Vec<T, N> x) -> Vec<C, N>
+{
+    if (std::is_constant_evaluated()) {
+        return [&]<std::size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+            return Vec<C, N>(detail::convert_member<C>(x[I])...);
+        }(std::make_index_sequence<N>{});
+    }
+    else {
+        return __builtin_convertvector(x.v, typename Vec<C, N>::native_type);
+    }
+}
+
+///
+template<typename T, std::size_t N>
+force_inline constexpr auto reduce_add(Vec<T, N> x) -> T
+{
+    auto sum = T{0};
+    for (std::size_t i = 0; i < N; ++i) {
+        sum += x[i];
+    }
+    return sum;
+}
+
+// MARK: - Math
+
+// Rounding, abs, min, max and friends are written with vector operations. The rest map the scalar function over the
+// members, which GCC can turn into libmvec calls with -ffast-math (or at least -fno-math-errno).
+
+template<typename T, std::size_t N>
+force_inline constexpr auto abs(Vec<T, N> x) -> Vec<T, N>
+{
+    if constexpr (std::is_unsigned_v<T>) {
+        return x;
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        // Clear the sign bit, so -0 gives 0.
+        return __builtin_bit_cast(Vec<T, N>, detail::as_bits(x) & ~detail::sign_bit_v<T>);
+    }
+    else {
+        return (x.v < 0) ? -x.v : x.v;
+    }
+}
+
+template<typename T, std::size_t N>
+force_inline constexpr auto min(Vec<T, N> a, Vec<T, N> b) -> Vec<T, N>
+{
+    return (a.v < b.v) ? a.v : b.v;
+}
+
+template<typename T, std::size_t N>
+force_inline constexpr auto max(Vec<T, N> a, Vec<T, N> b) -> Vec<T, N>
+{
+    return (a.v > b.v) ? a.v : b.v;
+}
+
+template<typename T, std::size_t N>
+force_inline constexpr auto clamp(Vec<T, N> x, Vec<T, N> a, Vec<T, N> b) -> Vec<T, N>
+{
+    return simd::min(simd::max(x, a), b);
+}
+
+/// -1 for negative members, 1 for positive members and 0 otherwise.
+template<typename T, std::size_t N>
+force_inline constexpr auto sign(Vec<T, N> x) -> Vec<T, N>
+{
+    const auto zero = Vec<T, N>(0);
+    return (x.v > 0) ? Vec<T, N>(1).v : ((x.v < 0) ? Vec<T, N>(-1).v : zero.v);
+}
+
+template<typename T, std::size_t N>
+force_inline constexpr auto trunc(Vec<T, N> x) -> Vec<T, N>
+{
+    // Values >= 2^sig_bits are already integers (as are infinities and NaNs), so the integer round trip is safe.
+    constexpr auto thresh = T(1) / std::numeric_limits<T>::epsilon();
+    using I = detail::mask_scalar_t<T>;
+    const auto t = simd::convert<T>(simd::convert<I>(x));
+    // Keep the sign of x, so -0.5 gives -0.
+    const auto sign = detail::as_bits(x) & detail::sign_bit_v<T>;
+    const auto signed_t = __builtin_bit_cast(Vec<T, N>, detail::as_bits(t) | sign);
+    return (simd::abs(x).v < thresh) ? signed_t.v : x.v;
+}
+
+template<typename T, std::size_t N>
+force_inline constexpr auto floor(Vec<T, N> x) -> Vec<T, N>
+{
+    const auto t = simd::trunc(x);
+    return (t.v > x.v) ? (t - 1).v : t.v;
+}
+
+template<typename T, std::size_t N>
+force_inline constexpr auto ceil(Vec<T, N> x) -> Vec<T, N>
+{
+    const auto t = simd::trunc(x);
+    return (t.v < x.v) ? (t + 1).v : t.v;
+}
+
+/// Rounds half away from zero.
+template<typename T, std::size_t N>
+force_inline constexpr auto round(Vec<T, N> x) -> Vec<T, N>
+{
+    // x - t is exact, so this doesn't suffer from the x + 0.5 rounding problem.
+    const auto t = simd::trunc(x);
+    return (simd::abs(x - t).v >= T(0.5)) ? (t + simd::sign(x)).v : t.v;
+}
+
+template<typename T, std::size_t N>
+force_inline auto fmod(Vec<T, N> x, Vec<T, N> y) -> Vec<T, N>
+{
+    return detail::map([](T a, T b) { return std::fmod(a, b); }, x, y);
+}
+
+template<typename T, std::size_t N>
+force_inline auto cos(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::cos(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto sin(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::sin(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto tan(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::tan(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto acos(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::acos(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto asin(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::asin(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto atan(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::atan(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto atan2(Vec<T, N> y, Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T a, T b) { return std::atan2(a, b); }, y, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto hypot(Vec<T, N> x, Vec<T, N> y) -> Vec<T, N>
+{
+    return detail::map([](T a, T b) { return std::hypot(a, b); }, x, y);
+}
+
+template<typename T, std::size_t N>
+force_inline auto cosh(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::cosh(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto sinh(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::sinh(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto tanh(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::tanh(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto acosh(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::acosh(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto asinh(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::asinh(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto atanh(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::atanh(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto erf(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::erf(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto exp2(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::exp2(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto log2(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::log2(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto exp(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::exp(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto log(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::log(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto log10(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::log10(s); }, x);
+}
+
+template<typename T, std::size_t N>
+force_inline auto pow(Vec<T, N> x, Vec<T, N> y) -> Vec<T, N>
+{
+    return detail::map([](T a, T b) { return std::pow(a, b); }, x, y);
+}
+
+/// One sqrt instruction per register. Vectors wider than the target's registers are split in halves, and members
+/// only go through std::sqrt (which may call libm to set errno) where there is no vector sqrt.
+template<typename T, std::size_t N>
+force_inline auto sqrt(Vec<T, N> x) -> Vec<T, N>
+{
+    using V = Vec<T, N>;
+#if defined(__AVX512F__)
+    if constexpr (sizeof(V) == 64 && sizeof(T) == 4) {
+        return __builtin_bit_cast(V, _mm512_sqrt_ps(__builtin_bit_cast(__m512, x)));
+    }
+    else if constexpr (sizeof(V) == 64) {
+        return __builtin_bit_cast(V, _mm512_sqrt_pd(__builtin_bit_cast(__m512d, x)));
+    }
+#endif
+#if defined(__AVX__)
+    if constexpr (sizeof(V) == 32 && sizeof(T) == 4) {
+        return __builtin_bit_cast(V, _mm256_sqrt_ps(__builtin_bit_cast(__m256, x)));
+    }
+    else if constexpr (sizeof(V) == 32) {
+        return __builtin_bit_cast(V, _mm256_sqrt_pd(__builtin_bit_cast(__m256d, x)));
+    }
+#endif
+#if defined(__SSE2__)
+    if constexpr (sizeof(V) == 16 && sizeof(T) == 4) {
+        return __builtin_bit_cast(V, _mm_sqrt_ps(__builtin_bit_cast(__m128, x)));
+    }
+    else if constexpr (sizeof(V) == 16) {
+        return __builtin_bit_cast(V, _mm_sqrt_pd(__builtin_bit_cast(__m128d, x)));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    if constexpr (sizeof(V) == 16 && sizeof(T) == 4) {
+        return __builtin_bit_cast(V, vsqrtq_f32(__builtin_bit_cast(float32x4_t, x)));
+    }
+    else if constexpr (sizeof(V) == 16) {
+        return __builtin_bit_cast(V, vsqrtq_f64(__builtin_bit_cast(float64x2_t, x)));
+    }
+#endif
+    if constexpr (sizeof(V) > 16) {
+        const auto halves = __builtin_bit_cast(std::array<Vec<T, N / 2>, 2>, x);
+        return __builtin_bit_cast(V, std::array{simd::sqrt(halves[0]), simd::sqrt(halves[1])});
+    }
+    else {
+        return detail::map([](T s) { return std::sqrt(s); }, x);
+    }
+}
+
+template<typename T, std::size_t N>
+force_inline auto cbrt(Vec<T, N> x) -> Vec<T, N>
+{
+    return detail::map([](T s) { return std::cbrt(s); }, x);
+}
+
+} // namespace vsl::simd
+
+#endif /* VSL_PORTABLE_SIMD */
+
+#endif /* _vsl_simd_h */
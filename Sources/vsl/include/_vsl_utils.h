@@ -1,9 +1,18 @@
 #ifndef _vsl_utils_h
 #define _vsl_utils_h
 
+#include <algorithm> // fill
+#include <array>
 #include <bit>
+#include <cstdint>
+#include <cstring> // memcpy
+#include <utility>
 
-#include <simd/simd.h>
+#if defined(__SSE2__)
+#include <immintrin.h> // movemask, and compress/expand with AVX-512
+#endif
+
+#include "_vsl_simd.h"
 
 #include "_vsl_core.h"
 
@@ -147,7 +156,7 @@ template<Unsigned X>
 force_inline constexpr auto reinterpret_as_float(X x)
 {
     using F = unsigned_counterpart_t<X>;
-    return std::bit_cast<F>(x);
+    return __builtin_bit_cast(F, x);
 }
 
 ///
@@ -155,7 +164,7 @@ template<FloatingPoint X>
 force_inline constexpr auto reinterpret_as_int(X x) -> uint_t<X>
 {
     using I = unsigned_counterpart_t<X>;
-    return std::bit_cast<I>(x);
+    return __builtin_bit_cast(I, x);
 }
 
 // MARK: - Equality
@@ -217,6 +226,36 @@ static_assert(bit_equal(1.f, 1.1f, 3));
 static_assert(!bit_equal(200.f, 201.f, 7));
 static_assert(!bit_equal(200.f, 202.f, 6));
 
+// MARK: - Members
+
+///
+template<typename X>
+force_inline auto get_member(X x, size_t i) -> scalar_t<X>
+{
+    if constexpr (is_vector_v<X>) {
+        return x[i % num_members_v<X>];
+    }
+    else {
+        return x;
+    }
+}
+
+/// Sets member i of x to s. (Writes go through here because the portable backend's operator[] is read-only.)
+template<typename X>
+force_inline constexpr auto set_member(X& x, size_t i, scalar_t<X> s) -> void
+{
+    if constexpr (is_vector_v<X>) {
+#if VSL_PORTABLE_SIMD
+        x.set(i % num_members_v<X>, s);
+#else
+        x[i % num_members_v<X>] = s;
+#endif
+    }
+    else {
+        x = s;
+    }
+}
+
 // MARK: - Masks
 
 ///
@@ -249,27 +288,473 @@ force_inline auto mask_for_member(size_t i) -> mask_t<X>
 {
     if constexpr (is_vector_v<X>) {
         auto mask = mask_t<X>(0);
-        mask[i % num_members_v<X>] = -1;
+        set_member(mask, i, -1);
         return mask;
     } else {
         return -1;
     }
 }
 
-// MARK: - Members
+// MARK: - Shuffles
 
-///
+namespace detail {
+
+/// The native vector extension type behind V, which __builtin_shufflevector works on.
+/// (By reference, since returning a 256- or 512-bit vector by value changes the ABI when AVX isn't enabled.)
+template<typename V>
+force_inline constexpr auto native(const V& v) -> const auto&
+{
+#if VSL_PORTABLE_SIMD
+    return v.v;
+#else
+    return v;
+#endif
+}
+
+} // namespace detail
+
+// Lane numbers below count up from member 0: shifting "up" moves member i to member i + n.
+
+/**
+ * @brief Picks members of a and b by compile-time index: member k is a[I_k] if I_k < N, else b[I_k - N].
+ *
+ * Compiles to a single shuffle where the target has one for the pattern (e.g. shufps, vpermt2ps, tbl), and works in
+ * constant expressions.
+ */
+template<size_t... I, typename V>
+    requires (is_vector_v<V> && sizeof...(I) == num_members_v<V> && ((I < 2 * num_members_v<V>) && ...))
+force_inline constexpr auto shuffle(V a, V b) -> V
+{
+    // Clang 18 can't shuffle during constant evaluation, so the members are picked from arrays there.
+    if (std::is_constant_evaluated()) {
+        using Members = std::array<scalar_t<V>, num_members_v<V>>;
+        constexpr auto width = num_members_v<V>;
+        const auto x = __builtin_bit_cast(Members, a);
+        const auto y = __builtin_bit_cast(Members, b);
+        return __builtin_bit_cast(V, Members{(I < width ? x[I] : y[I - width])...});
+    }
+    else {
+        return V(__builtin_shufflevector(detail::native(a), detail::native(b), I...));
+    }
+}
+
+static_assert(shuffle<0, 4, 1, 5>(float4{0, 1, 2, 3}, float4{4, 5, 6, 7})[1] == 4);
+
+/// Member k is x[I_k].
+template<size_t... I, typename V>
+    requires (is_vector_v<V> && sizeof...(I) == num_members_v<V> && ((I < num_members_v<V>) && ...))
+force_inline constexpr auto permute(V x) -> V
+{
+    return shuffle<I...>(x, x);
+}
+
+static_assert(permute<3, 2, 1, 0>(float4{0, 1, 2, 3})[0] == 3);
+
+/// Every member is x[K].
+template<size_t K, typename X>
+    requires (K < num_members_v<X>)
+force_inline constexpr auto broadcast(X x) -> X
+{
+    if constexpr (is_vector_v<X>) {
+        return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+            return permute<(I * 0 + K)...>(x);
+        }(std::make_index_sequence<num_members_v<X>>{});
+    }
+    else {
+        return x;
+    }
+}
+
+static_assert(broadcast<2>(double4{0, 1, 2, 3})[0] == 2);
+
+/// Member i is x[(i + n) mod N], like std::rotate: rotate<1>({a, b, c, d}) is {b, c, d, a}. n may be negative.
+template<int N, typename X>
+force_inline constexpr auto rotate(X x) -> X
+{
+    if constexpr (is_vector_v<X>) {
+        constexpr auto width = int(num_members_v<X>);
+        constexpr auto n = size_t((N % width + width) % width);
+        return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+            return permute<((I + n) % width)...>(x);
+        }(std::make_index_sequence<width>{});
+    }
+    else {
+        return x;
+    }
+}
+
+static_assert(rotate<1>(float4{0, 1, 2, 3})[3] == 0);
+static_assert(rotate<-1>(float4{0, 1, 2, 3})[0] == 3);
+
+/// The members in reverse order.
 template<typename X>
-force_inline auto get_member(X x, size_t i) -> scalar_t<X>
+force_inline constexpr auto reverse(X x) -> X
 {
     if constexpr (is_vector_v<X>) {
-        return x[i % num_members_v<X>];
+        constexpr auto width = num_members_v<X>;
+        return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+            return permute<(width - 1 - I)...>(x);
+        }(std::make_index_sequence<width>{});
     }
     else {
         return x;
     }
 }
 
+static_assert(reverse(double2{0, 1})[0] == 1);
+
+/// Member i is x[i - n], and the bottom n members are zero: shift_up<1>({a, b, c, d}) is {0, a, b, c}.
+template<size_t N, typename X>
+    requires (N <= num_members_v<X>)
+force_inline constexpr auto shift_up(X x) -> X
+{
+    if constexpr (is_vector_v<X>) {
+        constexpr auto width = num_members_v<X>;
+        return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+            return shuffle<(I >= N ? width + I - N : 0)...>(X(0), x);
+        }(std::make_index_sequence<width>{});
+    }
+    else {
+        return N == 0 ? x : X(0);
+    }
+}
+
+static_assert(shift_up<1>(float4{1, 2, 3, 4})[0] == 0);
+static_assert(shift_up<1>(float4{1, 2, 3, 4})[3] == 3);
+
+/// Member i is x[i + n], and the top n members are zero: shift_down<1>({a, b, c, d}) is {b, c, d, 0}.
+template<size_t N, typename X>
+    requires (N <= num_members_v<X>)
+force_inline constexpr auto shift_down(X x) -> X
+{
+    if constexpr (is_vector_v<X>) {
+        return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+            return shuffle<(I + N)...>(x, X(0));
+        }(std::make_index_sequence<num_members_v<X>>{});
+    }
+    else {
+        return N == 0 ? x : X(0);
+    }
+}
+
+static_assert(shift_down<1>(float4{1, 2, 3, 4})[0] == 2);
+static_assert(shift_down<1>(float4{1, 2, 3, 4})[3] == 0);
+
+/**
+ * @brief x shifted up by n members, with the top n members of prev coming in at the bottom.
+ *
+ * For a delay line across lanes: shift_in<1>({e, f, g, h}, {a, b, c, d}) is {d, e, f, g}, where prev is the block
+ * before x.
+ */
+template<size_t N, typename V>
+    requires (is_vector_v<V> && N <= num_members_v<V>)
+force_inline constexpr auto shift_in(V x, V prev) -> V
+{
+    constexpr auto width = num_members_v<V>;
+    return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+        return shuffle<(I < N ? width - N + I : width + I - N)...>(prev, x);
+    }(std::make_index_sequence<width>{});
+}
+
+static_assert(shift_in<1>(float4{4, 5, 6, 7}, float4{0, 1, 2, 3})[0] == 3);
+static_assert(shift_in<1>(float4{4, 5, 6, 7}, float4{0, 1, 2, 3})[3] == 6);
+
+/// x shifted up by one member, with s in member 0: shift_in({a, b, c, d}, s) is {s, a, b, c}. (For a scalar, s.)
+template<typename X>
+force_inline constexpr auto shift_in(X x, scalar_t<X> s) -> X
+{
+    if constexpr (is_vector_v<X>) {
+        return shift_in<1>(x, X(s));
+    }
+    else {
+        return s;
+    }
+}
+
+static_assert(shift_in(float4{1, 2, 3, 4}, 9.f)[0] == 9);
+static_assert(shift_in(float4{1, 2, 3, 4}, 9.f)[1] == 1);
+
+namespace detail {
+
+/// The first (Half = 0) or second half of the members of a and b, alternating: a[0], b[0], a[1], b[1]...
+template<size_t Half, typename V>
+force_inline constexpr auto zip(V a, V b) -> V
+{
+    constexpr auto width = num_members_v<V>;
+
+    return [&]<size_t... K>(std::index_sequence<K...>) __attribute__((always_inline)) {
+        return shuffle<(Half * width / 2 + K / 2 + K % 2 * width)...>(a, b);
+    }(std::make_index_sequence<width>{});
+}
+
+} // namespace detail
+
+/**
+ * @brief Transposes a square block of registers in place, so member j of row i becomes member i of row j.
+ *
+ * Takes log2(N) rounds of N shuffles, each zipping row i with row i + N/2. (A 4x4 float transpose is 8 shuffles,
+ * a 2x2 double one is 2.)
+ */
+template<typename V, size_t N>
+    requires (is_vector_v<V> && N == num_members_v<V> && std::has_single_bit(N))
+force_inline auto transpose(std::array<V, N>& rows) -> void
+{
+    constexpr auto rounds = std::bit_width(N) - 1;
+
+    [&]<size_t... R>(std::index_sequence<R...>) __attribute__((always_inline)) {
+        ((rows = [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+             return std::array<V, N>{detail::zip<I % 2>(rows[I / 2], rows[I / 2 + N / 2])...};
+         }(std::make_index_sequence<N>{}), void(R)), ...);
+    }(std::make_index_sequence<rounds>{});
+}
+
+/// Transposes a 2x2 block, e.g. two double2.
+template<typename V>
+    requires (is_vector_v<V> && num_members_v<V> == 2)
+force_inline auto transpose(V& r0, V& r1) -> void
+{
+    auto rows = std::array{r0, r1};
+    transpose(rows);
+    r0 = rows[0];
+    r1 = rows[1];
+}
+
+/// Transposes a 4x4 block, e.g. four float4.
+template<typename V>
+    requires (is_vector_v<V> && num_members_v<V> == 4)
+force_inline auto transpose(V& r0, V& r1, V& r2, V& r3) -> void
+{
+    auto rows = std::array{r0, r1, r2, r3};
+    transpose(rows);
+    r0 = rows[0];
+    r1 = rows[1];
+    r2 = rows[2];
+    r3 = rows[3];
+}
+
+// MARK: - Mask bits
+
+// Masks as bit sets: bit i is member i. For sparse work (active voices, non-silent channels), iterate the set bits
+// or pack the active members together instead of testing every member.
+
+namespace detail {
+
+/// The bottom (Half = 0) or top half of the members of v, as a vector of half the width.
+template<size_t Half, typename V>
+force_inline auto half(V v)
+{
+    constexpr auto width = num_members_v<V>;
+
+    return [&]<size_t... I>(std::index_sequence<I...>) __attribute__((always_inline)) {
+        return vector_of_t<scalar_t<V>, width / 2>(
+            __builtin_shufflevector(native(v), native(v), (Half * width / 2 + I)...));
+    }(std::make_index_sequence<width / 2>{});
+}
+
+} // namespace detail
+
+/// The mask as bits, like movemask: bit i is set if member i is.
+template<typename M>
+force_inline constexpr auto to_bits(M mask) -> uint32_t
+{
+    if constexpr (is_vector_v<M>) {
+        constexpr auto width = num_members_v<M>;
+
+        if (!std::is_constant_evaluated()) {
+#if defined(__SSE2__)
+            using S = scalar_t<M>; // (AVX and AVX-512 imply SSE2.)
+#endif
+#if defined(__AVX512F__)
+            if constexpr (sizeof(M) == 64 && sizeof(S) == 4) {
+                return _mm512_cmplt_epi32_mask(__builtin_bit_cast(__m512i, mask), _mm512_setzero_si512());
+            }
+            else if constexpr (sizeof(M) == 64) {
+                return _mm512_cmplt_epi64_mask(__builtin_bit_cast(__m512i, mask), _mm512_setzero_si512());
+            }
+#endif
+#if defined(__AVX__)
+            if constexpr (sizeof(M) == 32 && sizeof(S) == 4) {
+                return _mm256_movemask_ps(__builtin_bit_cast(__m256, mask));
+            }
+            else if constexpr (sizeof(M) == 32) {
+                return _mm256_movemask_pd(__builtin_bit_cast(__m256d, mask));
+            }
+#endif
+#if defined(__SSE2__)
+            if constexpr (sizeof(M) == 16 && sizeof(S) == 4) {
+                return _mm_movemask_ps(__builtin_bit_cast(__m128, mask));
+            }
+            else if constexpr (sizeof(M) == 16) {
+                return _mm_movemask_pd(__builtin_bit_cast(__m128d, mask));
+            }
+            else {
+                return to_bits(detail::half<0>(mask)) | to_bits(detail::half<1>(mask)) << width / 2;
+            }
+#endif
+        }
+
+        auto bits = uint32_t{0};
+        for (size_t i = 0; i < width; ++i) {
+            bits |= uint32_t(mask[i] != 0) << i;
+        }
+        return bits;
+    }
+    else {
+        return bool(mask);
+    }
+}
+
+static_assert(to_bits(int4{-1, 0, 0, -1}) == 0b1001);
+static_assert(to_bits(long2{0, -1}) == 0b10);
+static_assert(to_bits(true) == 1);
+
+/// The number of members set.
+template<typename M>
+force_inline constexpr auto count(M mask) -> size_t
+{
+    return std::popcount(to_bits(mask));
+}
+
+static_assert(count(int4{-1, 0, -1, -1}) == 3);
+
+/// The index of the first member set, or the number of members if none are.
+template<typename M>
+force_inline constexpr auto first_set(M mask) -> size_t
+{
+    return std::countr_zero(to_bits(mask) | uint32_t{1} << num_members_v<M>);
+}
+
+static_assert(first_set(int4{0, 0, -1, -1}) == 2);
+static_assert(first_set(int4{0, 0, 0, 0}) == 4);
+
+/// Calls f(i) for each member i set, in order.
+template<typename M, typename F>
+force_inline constexpr auto for_each_set(M mask, F f) -> void
+{
+    for (auto bits = to_bits(mask); bits != 0; bits &= bits - 1) {
+        f(size_t(std::countr_zero(bits)));
+    }
+}
+
+/**
+ * @brief Stores the members of x where mask is set next to each other at out, and returns how many there were.
+ *
+ * out needs room for a full register: without AVX-512 every member is stored, and the ones past the count are
+ * overwritten garbage. (The loop is branch-free, so it doesn't mispredict on random masks.)
+ */
+template<typename X>
+force_inline auto compress_store(scalar_t<X>* out, X x, mask_t<X> mask) -> size_t
+{
+    if constexpr (is_vector_v<X>) {
+        const auto bits = to_bits(mask);
+
+#if defined(__AVX512F__)
+        using S = scalar_t<X>;
+        if constexpr (sizeof(X) == 64 && sizeof(S) == 4) {
+            _mm512_mask_compressstoreu_ps(out, __mmask16(bits), __builtin_bit_cast(__m512, x));
+            return std::popcount(bits);
+        }
+        else if constexpr (sizeof(X) == 64) {
+            _mm512_mask_compressstoreu_pd(out, __mmask8(bits), __builtin_bit_cast(__m512d, x));
+            return std::popcount(bits);
+        }
+#if defined(__AVX512VL__)
+        else if constexpr (sizeof(X) == 32 && sizeof(S) == 4) {
+            _mm256_mask_compressstoreu_ps(out, __mmask8(bits), __builtin_bit_cast(__m256, x));
+            return std::popcount(bits);
+        }
+        else if constexpr (sizeof(X) == 32) {
+            _mm256_mask_compressstoreu_pd(out, __mmask8(bits), __builtin_bit_cast(__m256d, x));
+            return std::popcount(bits);
+        }
+        else if constexpr (sizeof(S) == 4) {
+            _mm_mask_compressstoreu_ps(out, __mmask8(bits), __builtin_bit_cast(__m128, x));
+            return std::popcount(bits);
+        }
+        else {
+            _mm_mask_compressstoreu_pd(out, __mmask8(bits), __builtin_bit_cast(__m128d, x));
+            return std::popcount(bits);
+        }
+#endif
+#endif
+
+        auto n = size_t{0};
+        for (size_t i = 0; i < num_members_v<X>; ++i) {
+            out[n] = x[i];
+            n += (bits >> i) & 1;
+        }
+        return n;
+    }
+    else {
+        *out = x;
+        return bool(mask);
+    }
+}
+
+/// The members of x where mask is set, next to each other from member 0. The rest are zero.
+template<typename X>
+force_inline auto compress(X x, mask_t<X> mask) -> X
+{
+    auto members = std::array<scalar_t<X>, num_members_v<X>>{};
+    const auto n = compress_store(members.data(), x, mask);
+    std::fill(members.begin() + n, members.end(), scalar_t<X>(0));
+
+    auto packed = X();
+    std::memcpy(&packed, members.data(), sizeof(X));
+    return packed;
+}
+
+/**
+ * @brief The inverse of compress_store: loads count(mask) values from in into the members where mask is set, in
+ * order. The other members are zero.
+ */
+template<typename X>
+force_inline auto expand_load(const scalar_t<X>* in, mask_t<X> mask) -> X
+{
+    if constexpr (is_vector_v<X>) {
+#if defined(__AVX512F__)
+        using S = scalar_t<X>;
+        if constexpr (sizeof(X) == 64 && sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm512_maskz_expandloadu_ps(__mmask16(to_bits(mask)), in));
+        }
+        else if constexpr (sizeof(X) == 64) {
+            return __builtin_bit_cast(X, _mm512_maskz_expandloadu_pd(__mmask8(to_bits(mask)), in));
+        }
+#if defined(__AVX512VL__)
+        else if constexpr (sizeof(X) == 32 && sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm256_maskz_expandloadu_ps(__mmask8(to_bits(mask)), in));
+        }
+        else if constexpr (sizeof(X) == 32) {
+            return __builtin_bit_cast(X, _mm256_maskz_expandloadu_pd(__mmask8(to_bits(mask)), in));
+        }
+        else if constexpr (sizeof(S) == 4) {
+            return __builtin_bit_cast(X, _mm_maskz_expandloadu_ps(__mmask8(to_bits(mask)), in));
+        }
+        else {
+            return __builtin_bit_cast(X, _mm_maskz_expandloadu_pd(__mmask8(to_bits(mask)), in));
+        }
+#endif
+#endif
+
+        auto x = X(0);
+        auto n = size_t{0};
+        for_each_set(mask, [&](size_t i) __attribute__((always_inline)) { set_member(x, i, in[n++]); });
+        return x;
+    }
+    else {
+        return bool(mask) ? *in : X(0);
+    }
+}
+
+/// The inverse of compress: the first count(mask) members of x, moved to the members where mask is set, in order.
+template<typename X>
+force_inline auto expand(X x, mask_t<X> mask) -> X
+{
+    auto members = std::array<scalar_t<X>, num_members_v<X>>{};
+    std::memcpy(members.data(), &x, sizeof(X));
+    return expand_load<X>(members.data(), mask);
+}
+
 // MARK: - Conversions
 
 ///
@@ -1,22 +1,43 @@
 #ifndef vsl_h
 #define vsl_h
 
+// simd backend (Apple simd or portable vector extensions)
+#include "_vsl_simd.h"
+
 // typedefs and traits
 #include "_vsl_core.h"
 
 // utility functions for writing simd-compatible code
 #include "_vsl_utils.h"
 
+// loads, stores, gathers, aligned buffers and a scratch arena
+#include "_vsl_memory.h"
+
 // constexpr math approximations
 #include "_vsl_cxm.h"
 
 // client-facing math library
 #include "_vsl_math.h"
 
+// compile-time tables with interpolated lookup
+#include "_vsl_lut.h"
+
+// compile-time minimax (Remez) polynomial and rational fits
+#include "_vsl_minimax.h"
+
 // simd-compatible random with mask reset
 #include "_vsl_rand.h"
 
 // complex numbers with basic arithmetic
 #include "_vsl_complex.h"
 
+// span-based kernels over whole buffers
+#include "_vsl_block.h"
+
+// power-of-two FFTs over split complex buffers
+#include "_vsl_fft.h"
+
+// block kernels compiled per ISA and picked at runtime
+#include "_vsl_dispatch.h"
+
 #endif /* vsl_h */
@@ -1,5 +1,8 @@
 #include <cassert>
 #include <iostream>
+#include <limits>
+#include <numbers>
+#include <vector>
 
 #include "include/vsl.h"
 
@@ -25,6 +28,776 @@ int main() {
     const auto mask_log2 = vsl::abs_equal(res_log2, ref_log2, tol);
     assert(vsl::all(mask_log2 == true_mask));
 
+    // exp2 (wide)
+    const auto arg_exp2_wide = vsl::native_float_t(3.5f);
+    const auto res_exp2_wide = vsl::cxm::exp2(arg_exp2_wide);
+    assert(vsl::all(vsl::abs_equal(res_exp2_wide, vsl::native_float_t(std::exp2(3.5f)), vsl::native_float_t(1e-5f))));
+
+    // poly: both schemes agree with a direct sum, for scalars and vectors, and ratio divides two of them.
+    {
+        constexpr auto c = std::array{0.5, -1.25, 2.0, 0.75, -0.125, 1.5, -0.0625};
+        for (const auto x : {-1.5, -0.3, 0.0, 0.7, 2.0}) {
+            auto sum = 0.0;
+            for (size_t k = c.size(); k-- > 0;) {
+                sum = sum * x + c[k];
+            }
+            assert(vsl::abs_equal(vsl::cxm::poly(x, c), sum, 1e-12));
+            assert(vsl::abs_equal(vsl::cxm::poly<vsl::Poly_scheme::estrin>(x, c), sum, 1e-12));
+
+            const auto v = vsl::cxm::poly<vsl::Poly_scheme::estrin>(vsl::double4{x, -x, 2 * x, 0}, c);
+            assert(vsl::abs_equal(v[0], sum, 1e-12) && v[3] == c[0]);
+        }
+        const auto r = vsl::cxm::ratio(vsl::float4{0, 1, 2, 3}, std::array{1.0, 1.0}, std::array{2.0, 0.0, 1.0});
+        assert(vsl::all(vsl::abs_equal(r, vsl::float4{0.5f, 2 / 3.f, 3 / 6.f, 4 / 11.f}, vsl::float4(1e-6f))));
+    }
+
+    // rcp, rsqrt, sqrt and cbrt: each tier within its documented error, for scalars and vectors, and 0 where defined.
+    {
+        for (auto x = 1e-30; x < 1e30; x *= 7.3) {
+            const auto f = static_cast<float>(x);
+            assert(vsl::rel_equal(vsl::cxm::rcp(-f), -1 / f, 3e-7f));
+            assert(vsl::rel_equal(vsl::cxm::rsqrt<vsl::precision::fast>(f), 1 / std::sqrt(f), 1e-5f));
+            assert(vsl::rel_equal(vsl::cxm::sqrt(f), std::sqrt(f), 3e-7f));
+            assert(vsl::rel_equal(vsl::cxm::cbrt(-f), std::cbrt(-f), 5e-7f));
+            assert(vsl::rel_equal(vsl::cxm::rcp<vsl::precision::full>(x), 1 / x, 3e-16));
+            assert(vsl::rel_equal(vsl::cxm::sqrt(x), std::sqrt(x), 1e-10));
+            assert(vsl::rel_equal(vsl::cxm::cbrt(x), std::cbrt(x), 1e-15));
+        }
+        const auto v = vsl::float8{0, 1e-20f, 0.5f, 1, 2, 3, 1e10f, 3e38f};
+        const auto sqrt_v = vsl::cxm::sqrt(v);
+        const auto cbrt_v = vsl::cxm::cbrt(-v);
+        for (size_t i = 0; i < 8; ++i) {
+            assert(std::abs(sqrt_v[i] - std::sqrt(v[i])) <= 3e-7f * std::sqrt(v[i]));
+            assert(std::abs(cbrt_v[i] - std::cbrt(-v[i])) <= 5e-7f * std::cbrt(v[i]));
+        }
+        assert(vsl::cxm::sqrt(0.0) == 0.0 && vsl::cxm::cbrt(0.0) == 0.0);
+    }
+
+    // atan2 around the circle, and at the axes and signed zeros, against std::atan2; hypot far from 1.
+    {
+        for (auto k = 0; k < 1000; ++k) {
+            const auto angle = -3.14 + 0.00628 * k;
+            const auto r = std::exp2(0.1 * k - 50);
+            const auto y = vsl::double2{r * std::sin(angle), std::sin(angle)};
+            const auto x = vsl::double2{r * std::cos(angle), std::cos(angle)};
+            const auto res = vsl::cxm::atan2(y, x);
+            const auto res_f = vsl::cxm::atan2<vsl::precision::full>(float(y[1]), float(x[1]));
+            assert(std::abs(res[0] - std::atan2(y[0], x[0])) < 1e-10);
+            assert(std::abs(res[1] - std::atan2(y[1], x[1])) < 1e-10);
+            assert(std::abs(res_f - std::atan2(float(y[1]), float(x[1]))) < 5e-7f);
+            assert(std::abs(vsl::cxm::atan(std::tan(angle / 2)) - angle / 2) < 1e-10);
+            assert(vsl::rel_equal(vsl::cxm::hypot(x[0], y[0]), r, 1e-10));
+        }
+        for (const auto y : {0.0, -0.0, 1.0, -1.0}) {
+            for (const auto x : {0.0, -0.0, 1.0, -1.0}) {
+                assert(vsl::cxm::atan2<vsl::precision::full>(y, x) == std::atan2(y, x));
+            }
+        }
+        assert(vsl::rel_equal(vsl::cxm::hypot<vsl::precision::full>(1e300, 1e300), std::hypot(1e300, 1e300), 3e-16));
+        assert(vsl::cxm::hypot(-INFINITY, 1.f) == INFINITY);
+    }
+
+    // tan, asin, acos, sinh, cosh and tanh have double tiers.
+    {
+        using vsl::precision::full;
+        const auto close = [](auto a, auto b, auto tol) { return std::abs(a - b) <= tol * std::abs(b); };
+        for (auto k = 0; k <= 1000; ++k) {
+            const auto x = -1 + 0.002 * k;
+            assert(close(vsl::cxm::asin<full>(x), std::asin(x), 1e-15));
+            assert(close(vsl::cxm::acos<full>(x), std::acos(x), 1e-15));
+            assert(close(vsl::cxm::tan<full>(1.5 * x), std::tan(1.5 * x), 1e-15));
+            assert(close(vsl::cxm::tanh<full>(5 * x), std::tanh(5 * x), 1e-15));
+            assert(close(vsl::cxm::tanh(5 * x), std::tanh(5 * x), 1e-10));
+            assert(close(vsl::cxm::sinh<full>(20 * x), std::sinh(20 * x), 1e-14));
+            assert(close(vsl::cxm::cosh<full>(20 * x), std::cosh(20 * x), 1e-14));
+            assert(close(vsl::cxm::asin(float(x)), std::asin(float(x)), 5e-7f));
+        }
+    }
+
+    // MARK: - Test vsl math
+
+    // rounding
+    const auto arg_round = vsl::float4{-2.5f, -0.5f, 0.49999997f, 1e20f};
+    const auto res_floor = vsl::floor(arg_round);
+    const auto res_round = vsl::round(arg_round);
+    for (size_t i = 0; i < 4; ++i) {
+        assert(res_floor[i] == std::floor(arg_round[i]));
+        assert(res_round[i] == std::round(arg_round[i]));
+    }
+
+    // sin, within 2 ULP, since Apple's simd::sin is its own vector implementation
+    const auto arg_sin = vsl::double2{0.5, -2.0};
+    const auto res_sin = vsl::sin(arg_sin);
+    for (size_t i = 0; i < 2; ++i) {
+        assert(vsl::rel_equal(res_sin[i], std::sin(arg_sin[i]), 2 * std::numeric_limits<double>::epsilon()));
+    }
+
+    // One call site for a table built at compile time and values computed at run time: approximate matches cxm
+    // in both, and exact matches std at run time. Constant evaluation never fuses a multiply and an add, and run time
+    // does where the target has FMA, so the two are only bit-identical without it.
+#if defined(__FMA__) || defined(__AVX512F__) || defined(__ARM_FEATURE_FMA)
+    constexpr auto fused = true;
+#else
+    constexpr auto fused = false;
+#endif
+    {
+        using vsl::Evaluation;
+        constexpr auto table = [] {
+            auto t = std::array<float, 16>{};
+            for (size_t i = 0; i < t.size(); ++i) {
+                t[i] = vsl::sin<Evaluation::approximate>(0.1f * i);
+            }
+            return t;
+        }();
+        constexpr auto exact_table = [] {
+            auto t = std::array<double, 16>{};
+            for (size_t i = 0; i < t.size(); ++i) {
+                t[i] = vsl::exp(-0.5 * i);
+            }
+            return t;
+        }();
+        for (size_t i = 0; i < table.size(); ++i) {
+            const auto x = 0.1f * i;
+            const auto y = vsl::sin<Evaluation::approximate>(x);
+            assert(y == vsl::cxm::sin(x));
+            assert(fused ? vsl::abs_equal(table[i], y, 4 * std::numeric_limits<float>::epsilon()) : table[i] == y);
+            assert(vsl::sin(x) == std::sin(x));
+            assert(vsl::rel_equal(exact_table[i], std::exp(-0.5 * i), 1e-15));
+        }
+        const auto v = vsl::float4{-2.5f, -0.5f, 0.5f, 1.5f};
+        const auto approx_round = vsl::round<Evaluation::approximate>(v);
+        const auto approx_sqrt = vsl::sqrt<Evaluation::approximate, vsl::Precision::fast>(v * v);
+        assert(vsl::all(approx_sqrt == vsl::cxm::sqrt<vsl::Precision::fast>(v * v)));
+        for (size_t i = 0; i < 4; ++i) {
+            assert(approx_round[i] == std::round(v[i]));
+        }
+    }
+
+    // The same over 4096 points each of exp2 (float, [-64, 64)) and sin (double, [-32, 32)).
+    {
+        using vsl::Evaluation;
+        constexpr auto n = size_t{4096};
+        constexpr auto exp2_x = [](size_t i) { return -64.f + 128.f * i / n; };
+        constexpr auto sin_x = [](size_t i) { return -32. + 64. * i / n; };
+        constexpr auto exp2_table = [&] {
+            auto t = std::array<float, n>{};
+            for (size_t i = 0; i < n; ++i) {
+                t[i] = vsl::exp2<Evaluation::approximate>(exp2_x(i));
+            }
+            return t;
+        }();
+        constexpr auto sin_table = [&] {
+            auto t = std::array<double, n>{};
+            for (size_t i = 0; i < n; ++i) {
+                t[i] = vsl::sin<Evaluation::approximate>(sin_x(i));
+            }
+            return t;
+        }();
+        for (size_t i = 0; i < n; ++i) {
+            const auto e = vsl::exp2<Evaluation::approximate>(exp2_x(i));
+            const auto s = vsl::sin<Evaluation::approximate>(sin_x(i));
+            if constexpr (fused) {
+                assert(vsl::rel_equal(e, exp2_table[i], 2 * std::numeric_limits<float>::epsilon()));
+                assert(vsl::abs_equal(s, sin_table[i], 2 * std::numeric_limits<double>::epsilon()));
+            } else {
+                assert(e == exp2_table[i] && s == sin_table[i]);
+            }
+        }
+    }
+
+    // MARK: - Test block
+
+    // Odd lengths exercise the unrolled loop, the single-register loop and the partial tail.
+    for (const size_t n : {size_t{0}, size_t{3}, size_t{37}, size_t{130}}) {
+        auto in = std::vector<float>(n);
+        auto out = std::vector<float>(n);
+        for (size_t i = 0; i < n; ++i) {
+            in[i] = 0.05f * i - 3;
+        }
+
+        vsl::block::cxm::exp2(in, out);
+        for (size_t i = 0; i < n; ++i) {
+            assert(vsl::rel_equal(out[i], std::exp2(in[i]), 1e-5f));
+        }
+
+        // Large arguments, sin and cos from one call.
+        auto sin_out = std::vector<double>(n);
+        auto cos_out = std::vector<double>(n);
+        auto phase = std::vector<double>(n);
+        for (size_t i = 0; i < n; ++i) {
+            phase[i] = 1000.0 * in[i];
+        }
+        vsl::block::cxm::sincos(phase, sin_out, cos_out);
+        for (size_t i = 0; i < n; ++i) {
+            assert(vsl::abs_equal(sin_out[i], std::sin(phase[i]), 1e-10));
+            assert(vsl::abs_equal(cos_out[i], std::cos(phase[i]), 1e-10));
+        }
+
+        vsl::block::clamp(in, -1.f, 1.f); // in-place
+        for (size_t i = 0; i < n; ++i) {
+            assert(in[i] >= -1 && in[i] <= 1);
+        }
+    }
+
+    // MARK: - Test complex
+
+    // Split-complex kernels against the scalar Complex operators, with a partial tail.
+    {
+        using C = vsl::Complex<float>;
+
+        auto a = std::vector<C>(37);
+        auto b = std::vector<C>(a.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            a[i] = {0.1f * i - 1, 0.5f - 0.03f * i};
+            b[i] = {0.2f * i, 1 + 0.07f * i};
+        }
+
+        auto storage = std::vector<float>(4 * a.size());
+        const auto split = [&](size_t k) {
+            const auto n = a.size();
+            return vsl::Split_complex<float>{{storage.data() + 2 * k * n, n}, {storage.data() + (2 * k + 1) * n, n}};
+        };
+        const auto sa = split(0);
+        const auto sb = split(1);
+        vsl::block::deinterleave(a, sa);
+        vsl::block::deinterleave(b, sb);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(sa.real[i] == a[i].real && sa.imag[i] == a[i].imag);
+        }
+
+        auto round_trip = std::vector<C>(a.size());
+        vsl::block::interleave(sa, round_trip);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(round_trip[i].real == a[i].real && round_trip[i].imag == a[i].imag);
+        }
+
+        const auto near = [](C x, C y) {
+            return vsl::abs_equal(x.real, y.real, 1e-5f) && vsl::abs_equal(x.imag, y.imag, 1e-5f);
+        };
+
+        auto prod = std::vector<float>(2 * a.size());
+        const auto sp = vsl::Split_complex<float>{{prod.data(), a.size()}, {prod.data() + a.size(), a.size()}};
+        vsl::block::cmul(sa, sb, sp);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(near(sp[i], a[i] * b[i]));
+        }
+
+        vsl::block::cmul_conj(sa, sb, sp);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(near(sp[i], a[i] * vsl::conj(b[i])));
+        }
+
+        vsl::block::cmac(sa, sb, sp);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(near(sp[i], a[i] * vsl::conj(b[i]) + a[i] * b[i]));
+        }
+
+        auto mag = std::vector<float>(a.size());
+        vsl::block::mag2(sa, mag);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(vsl::abs_equal(mag[i], vsl::norm(a[i]), 1e-6f));
+        }
+        vsl::block::mag(sa, mag);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(vsl::abs_equal(mag[i], std::hypot(a[i].real, a[i].imag), 1e-6f));
+        }
+
+        // Polar and back, in place.
+        auto phase = std::vector<float>(a.size());
+        vsl::block::to_polar(sa, mag, phase);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(vsl::abs_equal(mag[i], std::hypot(a[i].real, a[i].imag), 1e-5f));
+            assert(vsl::abs_equal(phase[i], std::atan2(a[i].imag, a[i].real), 1e-6f));
+        }
+        vsl::block::from_polar(mag, phase, sp);
+        vsl::block::to_polar(sp, sp.real, sp.imag);
+        vsl::block::from_polar(sp.real, sp.imag, sp);
+        for (size_t i = 0; i < a.size(); ++i) {
+            assert(near(sp[i], a[i]));
+        }
+    }
+
+    // MARK: - Test shuffles
+
+    // A prefix sum from shifts, and a delay line across blocks.
+    {
+        auto x = vsl::float16{};
+        for (size_t i = 0; i < 16; ++i) {
+            vsl::set_member(x, i, float(i + 1));
+        }
+        auto sum = x;
+        sum += vsl::shift_up<1>(sum);
+        sum += vsl::shift_up<2>(sum);
+        sum += vsl::shift_up<4>(sum);
+        sum += vsl::shift_up<8>(sum);
+        for (size_t i = 0; i < 16; ++i) {
+            assert(sum[i] == float((i + 1) * (i + 2) / 2));
+            assert(vsl::broadcast<15>(sum)[i] == vsl::reduce_add(x));
+            assert(vsl::rotate<-3>(x)[i] == x[(i + 13) % 16]);
+        }
+
+        const auto prev = vsl::double4{1, 2, 3, 4};
+        const auto next = vsl::double4{5, 6, 7, 8};
+        const auto delayed = vsl::shift_in<2>(next, prev);
+        assert(delayed[0] == 3 && delayed[1] == 4 && delayed[2] == 5 && delayed[3] == 6);
+        assert(vsl::shift_in(1.5, 2.5) == 2.5);
+        assert(vsl::rotate<1>(1.5f) == 1.5f);
+    }
+
+    // MARK: - Test mask bits
+
+    // Bits, compaction and expansion against a per-member loop, for every mask of a float4 and sparse wider ones.
+    {
+        const auto check = [](auto x, auto mask) {
+            using X = decltype(x);
+            constexpr auto width = vsl::num_members_v<X>;
+
+            auto bits = uint32_t{0};
+            auto active = std::vector<vsl::scalar_t<X>>{};
+            for (size_t i = 0; i < width; ++i) {
+                if (mask[i]) {
+                    bits |= uint32_t{1} << i;
+                    active.push_back(x[i]);
+                }
+            }
+            assert(vsl::to_bits(mask) == bits);
+            assert(vsl::count(mask) == active.size());
+            assert(vsl::first_set(mask) == (bits ? size_t(std::countr_zero(bits)) : width));
+
+            auto visited = uint32_t{0};
+            vsl::for_each_set(mask, [&](size_t i) { visited |= uint32_t{1} << i; });
+            assert(visited == bits);
+
+            auto out = std::array<vsl::scalar_t<X>, width>{};
+            assert(vsl::compress_store(out.data(), x, mask) == active.size());
+            const auto packed = vsl::compress(x, mask);
+            for (size_t i = 0; i < width; ++i) {
+                assert(i < active.size() ? out[i] == active[i] && packed[i] == active[i] : packed[i] == 0);
+            }
+
+            const auto restored = vsl::expand(packed, mask);
+            const auto loaded = vsl::expand_load<X>(active.data(), mask);
+            for (size_t i = 0; i < width; ++i) {
+                assert(restored[i] == (mask[i] ? x[i] : 0) && loaded[i] == restored[i]);
+            }
+        };
+
+        for (uint32_t bits = 0; bits < 16; ++bits) {
+            auto mask = vsl::int4(0);
+            for (size_t i = 0; i < 4; ++i) {
+                vsl::set_member(mask, i, (bits >> i) & 1 ? -1 : 0);
+            }
+            check(vsl::float4{1, 2, 3, 4}, mask);
+        }
+
+        auto x16 = vsl::float16{};
+        auto x8 = vsl::double8{};
+        for (size_t i = 0; i < 16; ++i) {
+            vsl::set_member(x16, i, float(i + 1));
+            vsl::set_member(x8, i, double(i + 1));
+        }
+        check(x16, (x16 > 12.f) | (x16 < 3.f));
+        check(x16, x16 > 20.f);
+        check(x8, (x8 == 3.0) | (x8 == 7.0));
+        check(vsl::double2{1, 2}, vsl::double2{1, 2} > 1.0);
+    }
+
+    // MARK: - Test channels
+
+    // Register transposes.
+    {
+        auto a = vsl::float4{0, 1, 2, 3};
+        auto b = vsl::float4{4, 5, 6, 7};
+        auto c = vsl::float4{8, 9, 10, 11};
+        auto d = vsl::float4{12, 13, 14, 15};
+        vsl::transpose(a, b, c, d);
+        for (size_t i = 0; i < 4; ++i) {
+            assert(a[i] == 4 * i && b[i] == 4 * i + 1 && c[i] == 4 * i + 2 && d[i] == 4 * i + 3);
+        }
+
+        auto x = vsl::double2{0, 1};
+        auto y = vsl::double2{2, 3};
+        vsl::transpose(x, y);
+        assert(x[0] == 0 && x[1] == 2 && y[0] == 1 && y[1] == 3);
+
+        auto rows = std::array<vsl::float8, 8>{};
+        for (size_t i = 0; i < 8; ++i) {
+            for (size_t j = 0; j < 8; ++j) {
+                vsl::set_member(rows[i], j, float(8 * i + j));
+            }
+        }
+        vsl::transpose(rows);
+        for (size_t i = 0; i < 8; ++i) {
+            for (size_t j = 0; j < 8; ++j) {
+                assert(rows[i][j] == float(8 * j + i));
+            }
+        }
+    }
+
+    // Interleaved, planar and lane-packed layouts round-trip, with partial tiles in both directions.
+    for (const size_t channels : {1, 2, 3, 4, 5, 8}) {
+        constexpr auto frames = size_t{13};
+        const auto sample = [](size_t f, size_t c) { return float(100 * c + f); };
+
+        auto interleaved = std::vector<float>(channels * frames);
+        for (size_t f = 0; f < frames; ++f) {
+            for (size_t c = 0; c < channels; ++c) {
+                interleaved[f * channels + c] = sample(f, c);
+            }
+        }
+
+        auto storage = std::vector<float>(channels * frames, -1);
+        auto planar = std::vector<std::span<float>>{};
+        for (size_t c = 0; c < channels; ++c) {
+            planar.push_back(std::span(storage).subspan(c * frames, frames));
+        }
+        vsl::block::deinterleave(interleaved, planar);
+        for (size_t f = 0; f < frames; ++f) {
+            for (size_t c = 0; c < channels; ++c) {
+                assert(planar[c][f] == sample(f, c));
+            }
+        }
+
+        const auto planar_in = std::vector<std::span<const float>>(planar.begin(), planar.end());
+        auto round_trip = std::vector<float>(interleaved.size());
+        vsl::block::interleave(planar_in, round_trip);
+        assert(round_trip == interleaved);
+
+        auto packed = std::vector<vsl::float4>(vsl::block::packed_size<vsl::float4>(channels, frames), 7);
+        vsl::block::pack<vsl::float4>(interleaved, channels, packed);
+        for (size_t f = 0; f < frames; ++f) {
+            for (size_t c = 0; c < (channels + 3) / 4 * 4; ++c) {
+                assert(packed[c / 4 * frames + f][c % 4] == (c < channels ? sample(f, c) : 0));
+            }
+        }
+
+        auto packed_from_planar = std::vector<vsl::float4>(packed.size(), 7);
+        vsl::block::pack<vsl::float4>(planar_in, packed_from_planar);
+        for (size_t i = 0; i < packed.size(); ++i) {
+            assert(vsl::all(packed_from_planar[i] == packed[i]));
+        }
+
+        std::fill(round_trip.begin(), round_trip.end(), -1);
+        vsl::block::unpack<vsl::float4>(packed, channels, round_trip);
+        assert(round_trip == interleaved);
+
+        std::fill(storage.begin(), storage.end(), -1);
+        vsl::block::unpack<vsl::float4>(packed, planar);
+        for (size_t f = 0; f < frames; ++f) {
+            for (size_t c = 0; c < channels; ++c) {
+                assert(planar[c][f] == sample(f, c));
+            }
+        }
+    }
+
+    // MARK: - Test fft
+
+    // Against a direct DFT, for sizes with and without the radix-2 pass, plus the inverse and the batched mode.
+    {
+        for (const size_t n : {1, 2, 8, 32, 64}) {
+            auto storage = std::vector<double>(4 * n);
+            const auto x = vsl::Split_complex<double>{{storage.data(), n}, {storage.data() + n, n}};
+            const auto y = vsl::Split_complex<double>{{storage.data() + 2 * n, n}, {storage.data() + 3 * n, n}};
+            for (size_t i = 0; i < n; ++i) {
+                x.real[i] = std::sin(0.3 * i) + 0.1 * i;
+                x.imag[i] = std::cos(1.7 * i);
+            }
+
+            auto fft = vsl::Fft<double>(n);
+            fft.forward(x, y);
+            for (size_t k = 0; k < n; ++k) {
+                auto sum = vsl::Complex<double>{0, 0};
+                for (size_t i = 0; i < n; ++i) {
+                    const auto phase = -2 * std::numbers::pi * double((i * k) % n) / double(n);
+                    sum = sum + x[i] * vsl::Complex<double>{std::cos(phase), std::sin(phase)};
+                }
+                assert(vsl::abs_equal(y[k].real, sum.real, 1e-12) && vsl::abs_equal(y[k].imag, sum.imag, 1e-12));
+            }
+
+            // In place.
+            fft.inverse(y, y);
+            for (size_t i = 0; i < n; ++i) {
+                assert(vsl::abs_equal(y[i].real, x[i].real, 1e-14) && vsl::abs_equal(y[i].imag, x[i].imag, 1e-14));
+            }
+        }
+
+        // Real transforms match the complex transform of the same signal.
+        for (const size_t n : {2, 4, 16, 128}) {
+            auto in = std::vector<float>(n);
+            auto storage = std::vector<float>(4 * n);
+            const auto z = vsl::Split_complex<float>{{storage.data(), n}, {storage.data() + n, n}};
+            const auto spectrum = vsl::Split_complex<float>{{storage.data() + 2 * n, n}, {storage.data() + 3 * n, n}};
+            for (size_t i = 0; i < n; ++i) {
+                in[i] = z.real[i] = std::sin(0.5f * i) + 0.25f;
+                z.imag[i] = 0;
+            }
+            vsl::Fft<float>(n).forward(z, z);
+
+            auto fft = vsl::Real_fft<float>(n);
+            fft.forward(in, spectrum);
+            for (size_t k = 0; k < fft.bins(); ++k) {
+                assert(vsl::abs_equal(spectrum.real[k], z.real[k], 1e-4f));
+                assert(vsl::abs_equal(spectrum.imag[k], z.imag[k], 1e-4f));
+            }
+
+            auto out = std::vector<float>(n);
+            fft.inverse(spectrum, out);
+            for (size_t i = 0; i < n; ++i) {
+                assert(vsl::abs_equal(out[i], in[i], 1e-5f));
+            }
+        }
+
+        // Each lane of Fft<float4> is an independent transform.
+        {
+            constexpr auto n = size_t{16};
+            auto batch = std::vector<vsl::float4>(2 * n);
+            auto channel = std::vector<float>(2 * n);
+            for (size_t i = 0; i < 2 * n; ++i) {
+                batch[i] = vsl::float4{0.1f * i, -0.2f * i, 1, std::sin(float(i))};
+            }
+            const auto sb = vsl::Split_complex<vsl::float4>{{batch.data(), n}, {batch.data() + n, n}};
+            vsl::Fft<vsl::float4>(n).forward(sb, sb);
+
+            auto fft = vsl::Fft<float>(n);
+            for (size_t lane = 0; lane < 4; ++lane) {
+                for (size_t i = 0; i < 2 * n; ++i) {
+                    const auto x = vsl::float4{0.1f * i, -0.2f * i, 1, std::sin(float(i))};
+                    channel[i] = x[lane];
+                }
+                const auto sc = vsl::Split_complex<float>{{channel.data(), n}, {channel.data() + n, n}};
+                fft.forward(sc, sc);
+                for (size_t k = 0; k < n; ++k) {
+                    assert(vsl::abs_equal(sb.real[k][lane], sc.real[k], 1e-5f));
+                    assert(vsl::abs_equal(sb.imag[k][lane], sc.imag[k], 1e-5f));
+                }
+            }
+        }
+    }
+
+    // MARK: - Test dispatch
+
+    // Every kernel the CPU supports, not just the active one.
+    {
+        using Exp2 = vsl::dispatch::detail::Kernel<vsl::dispatch::cxm::detail::exp2_op, std::span<const float>,
+                                                   std::span<float>>;
+        using Isa = vsl::dispatch::Instruction_set;
+
+        auto in = std::vector<float>(101);
+        auto out = std::vector<float>(in.size());
+        for (size_t i = 0; i < in.size(); ++i) {
+            in[i] = 0.05f * i - 3;
+        }
+
+        for (const auto isa : {Isa::baseline, Isa::sse4_2, Isa::avx2, Isa::avx512, Isa::neon}) {
+            if (!vsl::dispatch::supported(isa)) {
+                continue;
+            }
+            Exp2::select(isa)(in, out);
+            for (size_t i = 0; i < in.size(); ++i) {
+                assert(vsl::rel_equal(out[i], std::exp2(in[i]), 1e-5f));
+            }
+        }
+
+        assert(vsl::dispatch::supported(vsl::dispatch::active()));
+        vsl::dispatch::cxm::clamp(in, -1.f, 1.f);
+        for (const auto x : in) {
+            assert(x >= -1 && x <= 1);
+        }
+
+        // Same stream as next(), whatever the register width.
+        auto gen_a = vsl::Random_gen<vsl::float16>{-1, 1};
+        auto gen_b = vsl::Random_gen<vsl::float16>{-1, 1};
+        vsl::dispatch::fill(gen_a, std::span<float>(out));
+        for (size_t i = 0; i < out.size(); i += 16) {
+            const auto x = gen_b.next();
+            for (size_t j = i; j < std::min(i + 16, out.size()); ++j) {
+                assert(vsl::abs_equal(out[j], x[j - i], 1e-6f));
+            }
+        }
+    }
+
+    // MARK: - Test memory
+
+    // Aligned, zero-padded buffers that the block kernels take directly.
+    {
+        auto buf = vsl::Aligned_buffer<float>(37);
+        assert(buf.size() == 37 && buf.padded_size() == 48);
+        assert(reinterpret_cast<uintptr_t>(buf.data()) % vsl::buffer_alignment == 0);
+        for (const auto x : buf.padded()) {
+            assert(x == 0);
+        }
+
+        for (size_t i = 0; i < buf.size(); ++i) {
+            buf[i] = 0.1f * i;
+        }
+        vsl::dispatch::cxm::clamp(buf, 0.f, 1.f);
+        auto copy = buf;
+        vsl::block::cxm::sin(buf, copy);
+        for (size_t i = 0; i < buf.size(); ++i) {
+            assert(vsl::abs_equal(copy[i], std::sin(std::min(0.1f * i, 1.f)), 1e-4f));
+        }
+        assert(copy.padded()[buf.size()] == 0);
+
+        auto vectors = vsl::Aligned_buffer<vsl::double2>(3);
+        assert(vectors.scalars().size() == 6 && vectors.padded_size() == 4);
+        vsl::dispatch::cxm::exp2(vectors.scalars());
+        assert(vsl::abs_equal(vectors[2][1], 1.0, 1e-9));
+    }
+
+    // An arena hands out aligned spans until it runs out, and reset() reuses the same memory.
+    {
+        constexpr auto capacity = vsl::Arena::size_for<float>(100) + vsl::Arena::size_for<vsl::double2>(7);
+        auto arena = vsl::Arena(capacity);
+        assert(arena.capacity() == capacity);
+
+        const auto a = arena.allocate<float>(100);
+        const auto b = arena.allocate<vsl::double2>(7);
+        assert(a.size() == 100 && b.size() == 7 && arena.used() == capacity);
+        assert(reinterpret_cast<uintptr_t>(b.data()) % vsl::buffer_alignment == 0);
+        assert(reinterpret_cast<const std::byte*>(b.data()) >= reinterpret_cast<const std::byte*>(a.data() + a.size()));
+
+        std::fill(a.begin(), a.end(), 2.f);
+        vsl::block::cxm::log2(a);
+        assert(vsl::abs_equal(a[99], 1.f, 1e-6f));
+
+        arena.reset();
+        const auto c = arena.allocate<float>(100);
+        assert(c.data() == a.data() && c[0] == 0);
+    }
+
+    // Gathers and scatters match a loop over the indices, and a scatter to repeated indices keeps the last member.
+    {
+        auto table = std::array<float, 64>{};
+        auto doubles = std::array<double, 64>{};
+        for (size_t i = 0; i < table.size(); ++i) {
+            table[i] = 0.5f * i;
+            doubles[i] = -0.25 * i;
+        }
+
+        const auto idx4 = vsl::int4{7, 0, 63, 7};
+        const auto g4 = vsl::gather<vsl::float4>(table.data(), idx4);
+        const auto idx16 = vsl::int16{3, 1, 4, 1, 5, 9, 2, 6, 53, 58, 9, 7, 9, 3, 2, 38};
+        const auto g16 = vsl::gather<vsl::float16>(table.data(), idx16);
+        const auto idx8 = vsl::long8{62, 2, 0, 33, 41, 5, 5, 12};
+        const auto g8 = vsl::gather<vsl::double8>(doubles.data(), idx8);
+        for (size_t i = 0; i < 16; ++i) {
+            assert(i >= 4 || g4[i] == table[idx4[i]]);
+            assert(g16[i] == table[idx16[i]]);
+            assert(i >= 8 || g8[i] == doubles[idx8[i]]);
+        }
+        assert(vsl::gather<float>(table.data(), 9) == 4.5f);
+
+        auto out = std::array<float, 64>{};
+        vsl::scatter(out.data(), idx4, vsl::float4{1, 2, 3, 4});
+        assert(out[7] == 4 && out[0] == 2 && out[63] == 3 && out[1] == 0);
+        auto out8 = std::array<double, 64>{};
+        vsl::scatter(out8.data(), idx8, g8);
+        for (size_t i = 0; i < 8; ++i) {
+            assert(out8[idx8[i]] == doubles[idx8[i]]);
+        }
+    }
+
+    // Masked loads and stores touch only the active members, so a block's tail needs no scalar loop.
+    {
+        auto buf = vsl::Aligned_buffer<float>(19);
+        for (size_t i = 0; i < buf.size(); ++i) {
+            buf[i] = float(i + 1);
+        }
+        const auto tail = buf.size() % 8;
+        const auto mask = vsl::mask_first<vsl::float8>(tail);
+        assert(vsl::count(mask) == tail);
+
+        const auto x = vsl::load_masked<vsl::float8>(buf.data() + 16, mask);
+        for (size_t i = 0; i < 8; ++i) {
+            assert(x[i] == (i < tail ? buf[16 + i] : 0));
+        }
+
+        vsl::store_masked(buf.data() + 16, vsl::float8{-1}, mask);
+        assert(buf[18] == -1 && buf[15] == 16 && buf.padded()[19] == 0);
+        vsl::store_masked(buf.data() + 4, vsl::float4{-2}, vsl::mask_first<vsl::float4>(0));
+        assert(buf[4] == 5);
+        vsl::store_masked(buf.data(), 7.f, vsl::mask_first<float>(1));
+        assert(buf[0] == 7);
+    }
+
+    // Aligned and streaming stores write the same values as plain ones once the stream is fenced.
+    {
+        auto a = vsl::Aligned_buffer<double>(32);
+        auto b = vsl::Aligned_buffer<double>(32);
+        for (size_t i = 0; i < 32; i += 8) {
+            const auto x = vsl::double8{double(i), 1, 2, 3, 4, 5, 6, 7};
+            vsl::store_aligned(a.data() + i, x);
+            vsl::store_streaming(b.data() + i, x);
+            assert(vsl::load_aligned<vsl::double8>(a.data() + i)[0] == double(i));
+        }
+        vsl::store_streaming(b.data() + 1, 42.0);
+        vsl::stream_fence();
+        for (size_t i = 0; i < 32; ++i) {
+            assert(b[i] == (i == 1 ? 42 : a[i]));
+        }
+        assert(vsl::load<vsl::double2>(a.data() + 7)[1] == 8);
+    }
+
+    // MARK: - Test lut
+
+    // Vector lookups match scalar ones to 1 ULP of the table's range (the compiler may fuse the multiply-adds in one
+    // and not the other), and each interpolation is within its expected error of sin.
+    {
+        constexpr auto pi = std::numbers::pi_v<float>;
+        constexpr auto sin_f = [](double x) { return vsl::cxm::sin<vsl::precision::full>(x); };
+        static constexpr auto linear = vsl::lut<256>(sin_f, -pi, pi);
+        static constexpr auto hermite = vsl::lut<256, vsl::Interpolation::hermite>(sin_f, -pi, pi);
+        static constexpr auto chebyshev = vsl::lut<256, vsl::Interpolation::chebyshev>(sin_f, -pi, pi);
+
+        const auto check = [](const auto& table, float tol) {
+            for (int i = -1000; i < 1000; i += 4) {
+                const auto x = vsl::float4{0.0031f * i, 0.0031f * (i + 1), 0.0031f * (i + 2), 0.0031f * (i + 3)};
+                const auto y = table(x);
+                for (size_t j = 0; j < 4; ++j) {
+                    assert(vsl::abs_equal(y[j], table(x[j]), std::numeric_limits<float>::epsilon()));
+                    assert(vsl::abs_equal(y[j], std::sin(x[j]), tol));
+                }
+            }
+        };
+        check(linear, 8e-5f);
+        check(hermite, 1e-6f);
+        check(chebyshev, 1e-6f);
+
+        // Clamped outside the domain.
+        assert(vsl::abs_equal(linear(10.f), 0.f, 1e-6f));
+    }
+
+    // MARK: - Test minimax
+
+    // Compile-time fits: the reported error is the real one, a rational fit beats a polynomial of the same size, and
+    // a relative fit of exp is within rounding.
+    {
+        constexpr auto tanh_f = [](double x) { return 1 - 2 / (vsl::cxm::exp<vsl::precision::full>(2 * x) + 1); };
+        constexpr auto exp_f = [](double x) { return vsl::cxm::exp<vsl::precision::full>(x); };
+        static constexpr auto poly_5 = vsl::minimax<5, float>(tanh_f, -3, 3);
+        static constexpr auto ratio_5_4 = vsl::minimax_ratio<5, 4, float>(tanh_f, -3, 3);
+        static constexpr auto exp_12 = vsl::minimax<12>(exp_f, -0.5, 0.5, vsl::Fit_error::relative);
+        static_assert(poly_5.error < 0.05 && ratio_5_4.error < 1e-4 && exp_12.error < 1e-15);
+        static_assert(ratio_5_4.q[0] == 1);
+
+        auto max_poly = 0.0;
+        auto max_ratio = 0.0;
+        for (int i = -3000; i <= 3000; ++i) {
+            const auto x = i / 1000.0;
+            max_poly = std::max(max_poly, std::abs(vsl::cxm::poly(x, poly_5.coefficients) - std::tanh(x)));
+            max_ratio = std::max(max_ratio, std::abs(vsl::cxm::ratio(x, ratio_5_4.p, ratio_5_4.q) - std::tanh(x)));
+        }
+        assert(max_poly <= poly_5.error * 1.001 && max_poly > poly_5.error * 0.99);
+        assert(max_ratio <= ratio_5_4.error * 1.01);
+
+        const auto x = vsl::float4{-2.5f, -0.1f, 0.7f, 3};
+        const auto y = vsl::cxm::poly(x, poly_5.coefficients);
+        for (size_t i = 0; i < 4; ++i) {
+            assert(vsl::abs_equal(y[i], std::tanh(x[i]), float(poly_5.error) + 1e-6f));
+            assert(vsl::rel_equal(vsl::cxm::poly(x[i] / 6.0, exp_12.coefficients), std::exp(x[i] / 6.0), 1e-15));
+        }
+    }
+
     // MARK: - Test Random_gen
 
     // float
@@ -76,5 +849,126 @@ int main() {
 #endif
     }
     
+    // float8
+    auto f8rng = vsl::Random_gen<vsl::float8>{-1, 1};
+
+    for (size_t i = 0; i < 10; ++i) {
+        if (i == 5) {
+            f8rng.reset(vsl::mask_for_member<vsl::float8>(7));
+        }
+
+        [[maybe_unused]] const auto v = f8rng.next();
+        assert(vsl::all((v >= -1) & (v < 1)));
+    }
+
+    // Lanes are independent streams, and discard(n) matches n calls to next().
+    {
+        const auto check = []<vsl::Random_engine E>() {
+            auto a = vsl::Random_gen<vsl::float4, E>{-1, 1, 1234};
+            auto b = a;
+            const auto first = a.next();
+            assert(first[0] != first[1] && first[1] != first[2] && first[2] != first[3]);
+
+            for (int i = 0; i < 999; ++i) {
+                a.next();
+            }
+            b.discard(1000);
+            assert(vsl::all(a.next() == b.next()));
+
+            // A scalar generator is lane 0's stream, for the engines with 32-bit lanes.
+            if constexpr (E == vsl::Random_engine::linear_congruential || E == vsl::Random_engine::xorshift) {
+                auto c = vsl::Random_gen<float, E>{-1, 1, 1234};
+                c.discard(1001);
+                assert(c.next() == a.next()[0]);
+            }
+        };
+        check.template operator()<vsl::Random_engine::linear_congruential>();
+        check.template operator()<vsl::Random_engine::xorshift>();
+        check.template operator()<vsl::Random_engine::counter>();
+        check.template operator()<vsl::Random_engine::pcg>();
+        check.template operator()<vsl::Random_engine::xoshiro128_plus>();
+        check.template operator()<vsl::Random_engine::xoshiro256_plus>();
+
+        // With 64-bit engines, pairs of float lanes share a state and restart together.
+        auto pcg = vsl::Random_gen<vsl::float4, vsl::Random_engine::pcg>{0, 1};
+        const auto start = pcg.next();
+        pcg.next();
+        pcg.reset(vsl::mask_for_member<vsl::float4>(1));
+        const auto restarted = pcg.next();
+        assert(restarted[0] == start[0] && restarted[1] == start[1]);
+        assert(restarted[2] != start[2] && restarted[3] != start[3]);
+
+        // The 64-bit xorshift jump, directly and through a generator.
+        {
+            using J = vsl::detail::Xorshift_jump<uint64_t>;
+            auto x = uint64_t{808};
+            for (int i = 0; i < 100; ++i) {
+                x = vsl::detail::xorshift_step(x);
+            }
+            assert(x == J(100)(808u) && J(0)(808u) == 808u);
+        }
+        auto d = vsl::Random_gen<vsl::double2, vsl::Random_engine::xorshift>{0, 1};
+        auto e = d;
+        d.discard(12345);
+        for (int i = 0; i < 12345; ++i) {
+            e.next();
+        }
+        assert(vsl::all(d.next() == e.next()));
+
+        // Bulk fills produce the same values as next(), and reset() still rewinds.
+        auto g = vsl::Random_gen<vsl::float4>{-1, 1, 7};
+        auto h = g;
+        auto block = std::vector<vsl::float4>(23);
+        g.fill(std::span(block));
+        for (const auto& v : block) {
+            assert(vsl::all(v == h.next()));
+        }
+        g.reset();
+        auto flat = std::vector<float>(4 * block.size() - 1);
+        g.fill(std::span(flat));
+        for (size_t i = 0; i < flat.size(); ++i) {
+            assert(flat[i] == block[i / 4][i % 4]);
+        }
+
+        // Distributions: bulk fills match next(), including an odd count and a pending Box-Muller value, and the
+        // moments are close to the distribution's.
+        const auto check_distribution = [](auto gen, double mean, double variance, double lo, double hi) {
+            auto reference = gen;
+            auto values = std::vector<float>(4 * 4001 - 1);
+            gen.fill(std::span(reinterpret_cast<vsl::float4*>(values.data()), 1));
+            gen.fill(std::span(values).subspan(4));
+            for (size_t i = 0; i < values.size(); i += 4) {
+                const auto x = reference.next();
+                for (size_t j = 0; j < 4 && i + j < values.size(); ++j) {
+                    assert(x[j] == values[i + j]);
+                }
+            }
+
+            auto sum = 0.0;
+            auto sum2 = 0.0;
+            for (const auto x : values) {
+                assert(x >= lo && x <= hi);
+                sum += x;
+                sum2 += double(x) * x;
+            }
+            const auto m = sum / values.size();
+            assert(std::abs(m - mean) < 0.03);
+            assert(std::abs(sum2 / values.size() - m * m - variance) < 0.03);
+        };
+        check_distribution(vsl::Normal_gen<vsl::float4>{}, 0, 1, -6, 6);
+        check_distribution(vsl::Normal_gen<vsl::float4, vsl::Random_engine::xorshift>{0.5f, 0.5f}, 0.5, 0.25, -3, 4);
+        check_distribution(vsl::Exponential_gen<vsl::float4>{2}, 0.5, 0.25, 0, 10);
+        check_distribution(vsl::Triangular_gen<vsl::float4>{-1, 1}, 0, 1.0 / 6, -1, 1);
+
+        // The counter engine jumps straight to any index.
+        auto f = vsl::Random_gen<vsl::float8, vsl::Random_engine::counter>{0, 1, 99};
+        for (int i = 0; i < 41; ++i) {
+            f.next();
+        }
+        const auto x = f.next();
+        f.seek(41);
+        assert(vsl::all(f.next() == x));
+    }
+    
     return 0;
 }